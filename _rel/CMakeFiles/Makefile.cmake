@@ -0,0 +1,107 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/repo/CMakeLists.txt"
+  "/root/repo/CTestCustom.cmake"
+  "CMakeFiles/3.25.1/CMakeCCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/root/repo/contrib/gtest/CMakeLists.txt"
+  "/root/repo/contrib/gtest/cmake/internal_utils.cmake"
+  "/root/repo/test.cpp.in"
+  "/root/repo/test/CMakeLists.txt"
+  "/usr/share/cmake-3.25/Modules/CMakeCInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFile.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckLibraryExists.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/FindDoxygen.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageHandleStandardArgs.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageMessage.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPythonInterp.cmake"
+  "/usr/share/cmake-3.25/Modules/FindThreads.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "CTestCustom.cmake"
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  "contrib/gtest/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/SafeInt_operators.cpp"
+  "test/Packer_pack.cpp"
+  "test/BitIO_stream.cpp"
+  "test/FieldCodec_codec.cpp"
+  "test/PackedVector_container.cpp"
+  "test/PackedBulk_bulk.cpp"
+  "test/PackedTuple_tuple.cpp"
+  "test/PackedStruct_record.cpp"
+  "test/PackedOptional_optional.cpp"
+  "test/MixedRadix_radix.cpp"
+  "test/PackedVariant_variant.cpp"
+  "test/PackedEnum_enum.cpp"
+  "test/SafeStepped_stepped.cpp"
+  "test/Quantized_quantized.cpp"
+  "test/SafeFixed_fixed.cpp"
+  "test/safe_int_mul_overflow_mul_overflow.cpp"
+  "test/SafeExpr_expr.cpp"
+  "test/SafeInt_policies.cpp"
+  "test/SafeSpan_span.cpp"
+  "test/SafeInt_wide.cpp"
+  "test/CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "CMakeFiles/BUILD_TESTS.dir/DependInfo.cmake"
+  "CMakeFiles/TEST.dir/DependInfo.cmake"
+  "contrib/gtest/CMakeFiles/gtest.dir/DependInfo.cmake"
+  "contrib/gtest/CMakeFiles/gtest_main.dir/DependInfo.cmake"
+  "test/CMakeFiles/SafeInt_operators.dir/DependInfo.cmake"
+  "test/CMakeFiles/Packer_pack.dir/DependInfo.cmake"
+  "test/CMakeFiles/BitIO_stream.dir/DependInfo.cmake"
+  "test/CMakeFiles/FieldCodec_codec.dir/DependInfo.cmake"
+  "test/CMakeFiles/PackedVector_container.dir/DependInfo.cmake"
+  "test/CMakeFiles/PackedBulk_bulk.dir/DependInfo.cmake"
+  "test/CMakeFiles/PackedTuple_tuple.dir/DependInfo.cmake"
+  "test/CMakeFiles/PackedStruct_record.dir/DependInfo.cmake"
+  "test/CMakeFiles/PackedOptional_optional.dir/DependInfo.cmake"
+  "test/CMakeFiles/MixedRadix_radix.dir/DependInfo.cmake"
+  "test/CMakeFiles/PackedVariant_variant.dir/DependInfo.cmake"
+  "test/CMakeFiles/PackedEnum_enum.dir/DependInfo.cmake"
+  "test/CMakeFiles/SafeStepped_stepped.dir/DependInfo.cmake"
+  "test/CMakeFiles/Quantized_quantized.dir/DependInfo.cmake"
+  "test/CMakeFiles/SafeFixed_fixed.dir/DependInfo.cmake"
+  "test/CMakeFiles/SafeInt_mul_overflow.dir/DependInfo.cmake"
+  "test/CMakeFiles/SafeExpr_expr.dir/DependInfo.cmake"
+  "test/CMakeFiles/SafeInt_policies.dir/DependInfo.cmake"
+  "test/CMakeFiles/SafeSpan_span.dir/DependInfo.cmake"
+  "test/CMakeFiles/SafeInt_wide.dir/DependInfo.cmake"
+  )
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../BitIO_stream"
+  "../BitIO_stream.pdb"
+  "CMakeFiles/BitIO_stream.dir/BitIO_stream.cpp.o"
+  "CMakeFiles/BitIO_stream.dir/BitIO_stream.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/BitIO_stream.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
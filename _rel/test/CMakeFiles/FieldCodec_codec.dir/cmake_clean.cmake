@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../FieldCodec_codec"
+  "../FieldCodec_codec.pdb"
+  "CMakeFiles/FieldCodec_codec.dir/FieldCodec_codec.cpp.o"
+  "CMakeFiles/FieldCodec_codec.dir/FieldCodec_codec.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/FieldCodec_codec.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
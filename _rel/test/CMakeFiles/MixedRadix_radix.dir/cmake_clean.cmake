@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../MixedRadix_radix"
+  "../MixedRadix_radix.pdb"
+  "CMakeFiles/MixedRadix_radix.dir/MixedRadix_radix.cpp.o"
+  "CMakeFiles/MixedRadix_radix.dir/MixedRadix_radix.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/MixedRadix_radix.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../PackedBulk_bulk"
+  "../PackedBulk_bulk.pdb"
+  "CMakeFiles/PackedBulk_bulk.dir/PackedBulk_bulk.cpp.o"
+  "CMakeFiles/PackedBulk_bulk.dir/PackedBulk_bulk.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/PackedBulk_bulk.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
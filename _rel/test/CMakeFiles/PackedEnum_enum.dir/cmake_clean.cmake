@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../PackedEnum_enum"
+  "../PackedEnum_enum.pdb"
+  "CMakeFiles/PackedEnum_enum.dir/PackedEnum_enum.cpp.o"
+  "CMakeFiles/PackedEnum_enum.dir/PackedEnum_enum.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/PackedEnum_enum.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../PackedOptional_optional"
+  "../PackedOptional_optional.pdb"
+  "CMakeFiles/PackedOptional_optional.dir/PackedOptional_optional.cpp.o"
+  "CMakeFiles/PackedOptional_optional.dir/PackedOptional_optional.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/PackedOptional_optional.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../PackedStruct_record"
+  "../PackedStruct_record.pdb"
+  "CMakeFiles/PackedStruct_record.dir/PackedStruct_record.cpp.o"
+  "CMakeFiles/PackedStruct_record.dir/PackedStruct_record.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/PackedStruct_record.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../PackedTuple_tuple"
+  "../PackedTuple_tuple.pdb"
+  "CMakeFiles/PackedTuple_tuple.dir/PackedTuple_tuple.cpp.o"
+  "CMakeFiles/PackedTuple_tuple.dir/PackedTuple_tuple.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/PackedTuple_tuple.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../PackedVariant_variant"
+  "../PackedVariant_variant.pdb"
+  "CMakeFiles/PackedVariant_variant.dir/PackedVariant_variant.cpp.o"
+  "CMakeFiles/PackedVariant_variant.dir/PackedVariant_variant.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/PackedVariant_variant.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
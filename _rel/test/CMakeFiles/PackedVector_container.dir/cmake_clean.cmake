@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../PackedVector_container"
+  "../PackedVector_container.pdb"
+  "CMakeFiles/PackedVector_container.dir/PackedVector_container.cpp.o"
+  "CMakeFiles/PackedVector_container.dir/PackedVector_container.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/PackedVector_container.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
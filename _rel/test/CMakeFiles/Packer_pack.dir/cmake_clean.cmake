@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../Packer_pack"
+  "../Packer_pack.pdb"
+  "CMakeFiles/Packer_pack.dir/Packer_pack.cpp.o"
+  "CMakeFiles/Packer_pack.dir/Packer_pack.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/Packer_pack.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
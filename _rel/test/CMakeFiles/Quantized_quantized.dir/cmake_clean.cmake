@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../Quantized_quantized"
+  "../Quantized_quantized.pdb"
+  "CMakeFiles/Quantized_quantized.dir/Quantized_quantized.cpp.o"
+  "CMakeFiles/Quantized_quantized.dir/Quantized_quantized.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/Quantized_quantized.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../SafeExpr_expr"
+  "../SafeExpr_expr.pdb"
+  "CMakeFiles/SafeExpr_expr.dir/SafeExpr_expr.cpp.o"
+  "CMakeFiles/SafeExpr_expr.dir/SafeExpr_expr.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/SafeExpr_expr.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
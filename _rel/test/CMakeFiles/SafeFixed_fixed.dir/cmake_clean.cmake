@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../SafeFixed_fixed"
+  "../SafeFixed_fixed.pdb"
+  "CMakeFiles/SafeFixed_fixed.dir/SafeFixed_fixed.cpp.o"
+  "CMakeFiles/SafeFixed_fixed.dir/SafeFixed_fixed.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/SafeFixed_fixed.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
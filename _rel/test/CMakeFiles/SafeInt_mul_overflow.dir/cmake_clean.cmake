@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../SafeInt_mul_overflow"
+  "../SafeInt_mul_overflow.pdb"
+  "CMakeFiles/SafeInt_mul_overflow.dir/safe_int_mul_overflow_mul_overflow.cpp.o"
+  "CMakeFiles/SafeInt_mul_overflow.dir/safe_int_mul_overflow_mul_overflow.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/SafeInt_mul_overflow.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
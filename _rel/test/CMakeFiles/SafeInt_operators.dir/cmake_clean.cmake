@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../SafeInt_operators"
+  "../SafeInt_operators.pdb"
+  "CMakeFiles/SafeInt_operators.dir/SafeInt_operators.cpp.o"
+  "CMakeFiles/SafeInt_operators.dir/SafeInt_operators.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/SafeInt_operators.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../SafeInt_policies"
+  "../SafeInt_policies.pdb"
+  "CMakeFiles/SafeInt_policies.dir/SafeInt_policies.cpp.o"
+  "CMakeFiles/SafeInt_policies.dir/SafeInt_policies.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/SafeInt_policies.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
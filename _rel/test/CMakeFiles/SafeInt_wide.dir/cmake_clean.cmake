@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../SafeInt_wide"
+  "../SafeInt_wide.pdb"
+  "CMakeFiles/SafeInt_wide.dir/SafeInt_wide.cpp.o"
+  "CMakeFiles/SafeInt_wide.dir/SafeInt_wide.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/SafeInt_wide.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
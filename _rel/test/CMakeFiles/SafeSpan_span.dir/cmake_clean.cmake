@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../SafeSpan_span"
+  "../SafeSpan_span.pdb"
+  "CMakeFiles/SafeSpan_span.dir/SafeSpan_span.cpp.o"
+  "CMakeFiles/SafeSpan_span.dir/SafeSpan_span.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/SafeSpan_span.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../SafeStepped_stepped"
+  "../SafeStepped_stepped.pdb"
+  "CMakeFiles/SafeStepped_stepped.dir/SafeStepped_stepped.cpp.o"
+  "CMakeFiles/SafeStepped_stepped.dir/SafeStepped_stepped.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/SafeStepped_stepped.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
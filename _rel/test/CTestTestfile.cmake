@@ -0,0 +1,46 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test
+# Build directory: /root/repo/_rel/test
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(SafeInt_operators "/root/repo/_rel/SafeInt_operators")
+set_tests_properties(SafeInt_operators PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;48;add_test;/root/repo/test/CMakeLists.txt;1;make_simple_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(Packer_pack "/root/repo/_rel/Packer_pack")
+set_tests_properties(Packer_pack PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;48;add_test;/root/repo/test/CMakeLists.txt;2;make_simple_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(BitIO_stream "/root/repo/_rel/BitIO_stream")
+set_tests_properties(BitIO_stream PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;48;add_test;/root/repo/test/CMakeLists.txt;3;make_simple_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(FieldCodec_codec "/root/repo/_rel/FieldCodec_codec")
+set_tests_properties(FieldCodec_codec PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;48;add_test;/root/repo/test/CMakeLists.txt;4;make_simple_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(PackedVector_container "/root/repo/_rel/PackedVector_container")
+set_tests_properties(PackedVector_container PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;48;add_test;/root/repo/test/CMakeLists.txt;5;make_simple_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(PackedBulk_bulk "/root/repo/_rel/PackedBulk_bulk")
+set_tests_properties(PackedBulk_bulk PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;48;add_test;/root/repo/test/CMakeLists.txt;6;make_simple_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(PackedTuple_tuple "/root/repo/_rel/PackedTuple_tuple")
+set_tests_properties(PackedTuple_tuple PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;48;add_test;/root/repo/test/CMakeLists.txt;7;make_simple_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(PackedStruct_record "/root/repo/_rel/PackedStruct_record")
+set_tests_properties(PackedStruct_record PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;48;add_test;/root/repo/test/CMakeLists.txt;8;make_simple_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(PackedOptional_optional "/root/repo/_rel/PackedOptional_optional")
+set_tests_properties(PackedOptional_optional PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;48;add_test;/root/repo/test/CMakeLists.txt;9;make_simple_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(MixedRadix_radix "/root/repo/_rel/MixedRadix_radix")
+set_tests_properties(MixedRadix_radix PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;48;add_test;/root/repo/test/CMakeLists.txt;10;make_simple_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(PackedVariant_variant "/root/repo/_rel/PackedVariant_variant")
+set_tests_properties(PackedVariant_variant PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;48;add_test;/root/repo/test/CMakeLists.txt;11;make_simple_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(PackedEnum_enum "/root/repo/_rel/PackedEnum_enum")
+set_tests_properties(PackedEnum_enum PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;48;add_test;/root/repo/test/CMakeLists.txt;12;make_simple_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(SafeStepped_stepped "/root/repo/_rel/SafeStepped_stepped")
+set_tests_properties(SafeStepped_stepped PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;48;add_test;/root/repo/test/CMakeLists.txt;13;make_simple_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(Quantized_quantized "/root/repo/_rel/Quantized_quantized")
+set_tests_properties(Quantized_quantized PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;48;add_test;/root/repo/test/CMakeLists.txt;14;make_simple_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(SafeFixed_fixed "/root/repo/_rel/SafeFixed_fixed")
+set_tests_properties(SafeFixed_fixed PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;48;add_test;/root/repo/test/CMakeLists.txt;15;make_simple_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(SafeInt_mul_overflow "/usr/bin/cmake" "--build" "." "--target" "SafeInt_mul_overflow" "--config" "Release")
+set_tests_properties(SafeInt_mul_overflow PROPERTIES  PASS_REGULAR_EXPRESSION "product result cannot be represented" WORKING_DIRECTORY "/root/repo/_rel" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;74;add_test;/root/repo/test/CMakeLists.txt;16;make_static_assert_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(SafeExpr_expr "/root/repo/_rel/SafeExpr_expr")
+set_tests_properties(SafeExpr_expr PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;48;add_test;/root/repo/test/CMakeLists.txt;17;make_simple_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(SafeInt_policies "/root/repo/_rel/SafeInt_policies")
+set_tests_properties(SafeInt_policies PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;48;add_test;/root/repo/test/CMakeLists.txt;18;make_simple_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(SafeSpan_span "/root/repo/_rel/SafeSpan_span")
+set_tests_properties(SafeSpan_span PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;48;add_test;/root/repo/test/CMakeLists.txt;19;make_simple_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(SafeInt_wide "/root/repo/_rel/SafeInt_wide")
+set_tests_properties(SafeInt_wide PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;48;add_test;/root/repo/test/CMakeLists.txt;20;make_simple_test;/root/repo/test/CMakeLists.txt;0;")
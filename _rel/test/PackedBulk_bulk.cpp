@@ -0,0 +1,160 @@
+// gtest
+#include "gtest/gtest.h"
+
+// rdk
+#include "bit_io.hpp"
+#include "packed_vector.hpp"
+
+// stdlib
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+  std::seed_seq &GetSeed()
+  {
+    static uint32_t const data[]
+    {
+      0x4995b708, 0xdccec1c3, 0xdd10a637, 0x58d5467d
+    , 0x541f433a, 0x2b83fea4, 0x1405243e, 0x26422185
+    , 0x8bd7a7f7, 0x2cb02968, 0x613f4a6d, 0x909177e6
+    , 0x3893ba89, 0xd37de2b8, 0x42573711, 0xa04f9441
+    , 0x4995b708, 0xdccec1c3, 0xdd10a637, 0x58d5467d
+    , 0x541f433a, 0x2b83fea4, 0x1405243e, 0x26422185
+    , 0x8bd7a7f7, 0x2cb02968, 0x613f4a6d, 0x909177e6
+    , 0x3893ba89, 0xd37de2b8, 0x42573711, 0xa04f9441
+    , 0x4995b708, 0xdccec1c3, 0xdd10a637, 0x58d5467d
+    , 0x541f433a, 0x2b83fea4, 0x1405243e, 0x26422185
+    , 0x8bd7a7f7, 0x2cb02968, 0x613f4a6d, 0x909177e6
+    , 0x3893ba89, 0xd37de2b8, 0x42573711, 0xa04f9441
+    , 0x4995b708, 0xdccec1c3, 0xdd10a637, 0x58d5467d
+    , 0x541f433a, 0x2b83fea4, 0x1405243e, 0x26422185
+    , 0x8bd7a7f7, 0x2cb02968, 0x613f4a6d, 0x909177e6
+    , 0x3893ba89, 0xd37de2b8, 0x42573711, 0xa04f9441
+    };
+    static std::seed_seq seq(std::begin(data), std::end(data));
+    return seq;
+  }
+
+  static std::mt19937 rng{GetSeed()};
+
+  /// uniformly distributed integer in [min, max]
+  /// the standard distributions take neither character types nor 128 bit integers, those are drawn through wider types
+  template<typename T>
+  T RandomInteger(T min, T max)
+  {
+    if constexpr(sizeof(T) < sizeof(int))
+    {
+      using dist_type = std::conditional_t<std::is_signed_v<T>, int, unsigned>;
+      std::uniform_int_distribution<dist_type> dist(min, max);
+      return static_cast<T>(dist(rng));
+    }
+#ifdef __SIZEOF_INT128__
+    else if constexpr(sizeof(T) > sizeof(uint64_t))
+    {
+      // two 64 bit halves, reduced to the range; slightly biased, which doesn't matter for testing
+      __extension__ typedef unsigned __int128 unsigned_type;
+      std::uniform_int_distribution<uint64_t> dist;
+      auto const bits = (static_cast<unsigned_type>(dist(rng)) << 64U) | static_cast<unsigned_type>(dist(rng));
+      auto const count = static_cast<unsigned_type>(static_cast<unsigned_type>(max) - static_cast<unsigned_type>(min) + 1U);
+      return static_cast<T>(static_cast<unsigned_type>(min) + ((0U == count) ? bits : (bits % count)));
+    }
+#endif
+    else
+    {
+      std::uniform_int_distribution<T> dist(min, max);
+      return dist(rng);
+    }
+  }
+
+  /// uniformly distributed value of a bounded type like a safe integer, constructed from its value_type
+  template<typename T>
+  T RandomValue()
+  {
+    using value_type = typename T::value_type;
+    return T{RandomInteger(static_cast<value_type>(std::numeric_limits<T>::min()), static_cast<value_type>(std::numeric_limits<T>::max()))};
+  }
+
+  /// like RandomValue, but the extremes show up often, they're the corners of the encoding
+  template<typename T>
+  T RandomCorner()
+  {
+    switch(rng() % 4U)
+    {
+    case 0U:
+      return std::numeric_limits<T>::min();
+    case 1U:
+      return std::numeric_limits<T>::max();
+    default:
+      return RandomValue<T>();
+    }
+  }
+
+  /// round trips values through pack / unpack, through a bit stream starting offset bits into the buffer, and through a packed_vector
+  /// the offset bits are set, so an encoding that doesn't mask its neighbours shows up
+  template<typename T>
+  void TestRoundTrip(std::vector<T> const &values, size_t expected_size, size_t offset)
+  {
+    using traits = rdk::packable_traits<T>;
+    static_assert(rdk::is_packable_v<T>, "round tripped types shall be packable");
+    ASSERT_EQ(expected_size, traits::packed_size);
+    ASSERT_GT(offset, 0U);
+    ASSERT_LT(offset, 64U);
+
+    std::vector<std::byte> buffer((offset + (values.size() * traits::packed_size) + 7U) / 8U);
+    rdk::bit_writer writer(buffer.data(), buffer.size());
+    writer.write((uint64_t{1U} << offset) - 1U, offset);
+    for(auto const &v : values)
+    {
+      writer.write(v);
+    }
+    writer.flush();
+
+    for(size_t i{}; i < values.size(); ++i)
+    {
+      ASSERT_TRUE(values[i] == traits::unpack(traits::pack(values[i]))) << traits::packed_size << ',' << i;
+      ASSERT_TRUE(values[i] == rdk::unpack_from<T>(buffer.data(), offset + (i * traits::packed_size))) << traits::packed_size << ',' << i;
+    }
+
+    rdk::packed_vector<T> const packed(values.begin(), values.end());
+    ASSERT_TRUE(std::equal(values.begin(), values.end(), packed.begin()));
+  }
+}
+
+#include "/root/repo/test/packed_bulk.cpp"
+
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+
+void signal_handler(int) 
+{
+  std::exit(EXIT_FAILURE);
+}
+
+int main(int argc, char *argv[])
+try
+{
+  if(SIG_ERR == std::signal(SIGABRT, signal_handler))
+  {
+    throw std::logic_error("failed to set up testing environment");
+  }
+
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+catch(std::exception &e)
+{
+  std::cerr << e.what() << std::endl;
+  return EXIT_FAILURE;
+}
+catch(...)
+{
+  return EXIT_FAILURE;
+}
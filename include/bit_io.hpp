@@ -0,0 +1,196 @@
+#pragma once
+#ifndef RDK_113B98E7CAEA4776AE22C287C99A1397
+#define RDK_113B98E7CAEA4776AE22C287C99A1397
+
+#include "packer.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace rdk
+{
+
+/// appends values bit by bit to a caller owned byte buffer
+/// bit i of the stream ends up in bit (i % 8) of byte (i / 8), so the buffer layout doesn't depend on the host
+/// bits are collected in a 64 bit accumulator and written out one whole word at a time
+class bit_writer
+{
+public:
+  constexpr bit_writer(std::byte *data, size_t size) noexcept
+    : data(data)
+    , size(size)
+  {
+  }
+
+  constexpr bit_writer(std::byte *first, std::byte *last) noexcept
+    : bit_writer(first, static_cast<size_t>(last - first))
+  {
+    assert(first <= last);
+  }
+
+  /// appends the lowest width (<= 64) bits of value
+  void write(uint64_t value, size_t width) noexcept
+  {
+    assert(width <= detail::word_bits);
+    assert((bit_count() + width) <= (8U * size));
+    value &= detail::low_mask(width);
+    acc |= value << fill;
+
+    size_t const total = fill + width;
+    if(total >= detail::word_bits)
+    {
+      detail::store_le64(data + next, acc);
+      next += sizeof(uint64_t);
+      // remaining high bits of value; (x >> 1) >> (63 - fill) == x >> (64 - fill), but stays defined for fill == 0
+      acc = (value >> 1U) >> ((detail::word_bits - 1U) - fill);
+      fill = total - detail::word_bits;
+    }
+    else
+    {
+      fill = total;
+    }
+  }
+
+  /// appends all bits of a bitstream
+  template<size_t bits>
+  void write(bitstream<bits> const &v) noexcept
+  {
+    for(size_t i{}; i < (bits / detail::word_bits); ++i)
+    {
+      write(v.word(i), detail::word_bits);
+    }
+    if(0U != (bits % detail::word_bits))
+    {
+      write(v.word(bits / detail::word_bits), bits % detail::word_bits);
+    }
+  }
+
+  /// appends the packed representation of v, i.e. exactly packable_traits<T>::packed_size bits
+  template<typename T, typename = std::enable_if_t<is_packable_v<T>>>
+  void write(T const &v) noexcept(noexcept(packable_traits<T>::pack(v)))
+  {
+    write(packable_traits<T>::pack(v));
+  }
+
+  /// writes out the bytes of a pending partial word
+  /// writing may continue afterwards; the flushed bytes are simply rewritten once the word is complete
+  void flush() noexcept
+  {
+    detail::store_le64_partial(data + next, acc, (fill + 7U) / 8U);
+  }
+
+  /// number of bits written so far
+  constexpr size_t bit_count() const noexcept
+  {
+    return (8U * next) + fill;
+  }
+
+  /// number of bytes touched by the bits written so far
+  constexpr size_t byte_count() const noexcept
+  {
+    return (bit_count() + 7U) / 8U;
+  }
+
+private:
+  std::byte *data;
+  size_t size;
+  size_t next{};
+  uint64_t acc{};
+  size_t fill{};
+};
+
+/// reads values bit by bit from a byte buffer in the layout produced by bit_writer
+/// the buffer is consumed one whole word at a time; reading never touches bytes past the end of the buffer
+class bit_reader
+{
+public:
+  constexpr bit_reader(std::byte const *data, size_t size) noexcept
+    : data(data)
+    , size(size)
+  {
+  }
+
+  constexpr bit_reader(std::byte const *first, std::byte const *last) noexcept
+    : bit_reader(first, static_cast<size_t>(last - first))
+  {
+    assert(first <= last);
+  }
+
+  /// reads the next width (<= 64) bits
+  uint64_t read(size_t width) noexcept
+  {
+    assert(width <= detail::word_bits);
+    assert((bit_count() + width) <= (8U * size));
+
+    // invariant: avail < 64, the valid bits of acc are its lowest avail bits
+    uint64_t res = acc;
+    if(width > avail)
+    {
+      uint64_t const word = load();
+      res |= word << avail;
+      acc = (word >> 1U) >> ((width - avail) - 1U);
+      avail = (avail + detail::word_bits) - width;
+    }
+    else
+    {
+      acc >>= width;
+      avail -= width;
+    }
+    return res & detail::low_mask(width);
+  }
+
+  /// reads the next value of type T, which is either a bitstream or a packable type
+  template<typename T>
+  T read() noexcept
+  {
+    static_assert(detail::is_bitstream_v<T> || is_packable_v<T>, "bit_reader: can only read bitstreams and packable types");
+    if constexpr(detail::is_bitstream_v<T>)
+    {
+      T res;
+      for(size_t i{}; i < (T::size() / detail::word_bits); ++i)
+      {
+        res.insert(i * detail::word_bits, detail::word_bits, read(detail::word_bits));
+      }
+      if(0U != (T::size() % detail::word_bits))
+      {
+        res.insert(T::size() - (T::size() % detail::word_bits), T::size() % detail::word_bits, read(T::size() % detail::word_bits));
+      }
+      return res;
+    }
+    else
+    {
+      using traits = packable_traits<T>;
+      return traits::unpack(read<typename traits::packed_type>());
+    }
+  }
+
+  /// number of bits read so far
+  constexpr size_t bit_count() const noexcept
+  {
+    return (8U * next) - avail;
+  }
+
+private:
+  uint64_t load() noexcept
+  {
+    // the last word of the buffer may be incomplete, it reads as if padded with zero bytes
+    size_t const remaining = size - next;
+    uint64_t const res = (remaining >= sizeof(uint64_t))
+      ? detail::load_le64(data + next)
+      : detail::load_le64_partial(data + next, remaining);
+    next += sizeof(uint64_t);
+    return res;
+  }
+
+  std::byte const *data;
+  size_t size;
+  size_t next{};
+  uint64_t acc{};
+  size_t avail{};
+};
+
+} // namespace rdk
+
+#endif // !RDK_113B98E7CAEA4776AE22C287C99A1397
@@ -0,0 +1,76 @@
+#pragma once
+#ifndef RDK_E5256009830246139EE06834C1905DF6
+#define RDK_E5256009830246139EE06834C1905DF6
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define RDK_X86_64 1
+#endif
+
+#ifdef RDK_X86_64
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+/// enables instruction set extensions for a single function, so kernels can be selected at runtime
+/// MSVC allows intrinsics everywhere and doesn't need (or support) the attribute
+#if defined(_MSC_VER) && !defined(__clang__)
+#define RDK_TARGET(features)
+#else
+#define RDK_TARGET(features) __attribute__((target(features)))
+#endif
+
+namespace rdk
+{
+
+namespace detail
+{
+  /// instruction set extensions used by optional kernels
+  struct cpu_features
+  {
+    bool bmi2;
+    bool avx2;
+    bool avx512f;
+  };
+
+  inline cpu_features detect_cpu_features() noexcept
+  {
+    cpu_features res{};
+#ifdef RDK_X86_64
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4]{};
+    __cpuid(info, 0);
+    int const max_leaf = info[0];
+    if(max_leaf < 7)
+    {
+      return res;
+    }
+
+    // vector extensions also require the os to save the extended register state
+    __cpuid(info, 1);
+    bool const os_saves_ymm = (0 != (info[2] & (1 << 27))) && (0x6U == (_xgetbv(0) & 0x6U));
+    bool const os_saves_zmm = os_saves_ymm && (0xE0U == (_xgetbv(0) & 0xE0U));
+
+    __cpuidex(info, 7, 0);
+    res.bmi2 = (0 != (info[1] & (1 << 8)));
+    res.avx2 = os_saves_ymm && (0 != (info[1] & (1 << 5)));
+    res.avx512f = os_saves_zmm && (0 != (info[1] & (1 << 16)));
+#else
+    // these already take os support for the extended register state into account
+    __builtin_cpu_init();
+    res.bmi2 = (0 != __builtin_cpu_supports("bmi2"));
+    res.avx2 = (0 != __builtin_cpu_supports("avx2"));
+    res.avx512f = (0 != __builtin_cpu_supports("avx512f"));
+#endif
+#endif
+    return res;
+  }
+
+  /// features of the cpu we're running on, detected once at startup
+  inline cpu_features const cpu = detect_cpu_features();
+} // namespace detail
+
+} // namespace rdk
+
+#endif // !RDK_E5256009830246139EE06834C1905DF6
@@ -0,0 +1,306 @@
+#pragma once
+#ifndef RDK_DF8305255B864C3FB2C6937C356F6116
+#define RDK_DF8305255B864C3FB2C6937C356F6116
+
+#include "cpu_features.hpp"
+#include "packer.hpp"
+#include "safe_int.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace rdk
+{
+
+namespace detail
+{
+  constexpr uint64_t shl(uint64_t v, size_t n) noexcept
+  {
+    return (n < word_bits) ? (v << n) : 0U;
+  }
+
+  constexpr uint64_t shr(uint64_t v, size_t n) noexcept
+  {
+    return (n < word_bits) ? (v >> n) : 0U;
+  }
+
+  /// lane wise a + b, each lane's most significant bit is set in high
+  constexpr uint64_t swar_add(uint64_t a, uint64_t b, uint64_t high) noexcept
+  {
+    return ((a & ~high) + (b & ~high)) ^ ((a ^ b) & high);
+  }
+
+  /// lane wise a - b, each lane's most significant bit is set in high
+  constexpr uint64_t swar_sub(uint64_t a, uint64_t b, uint64_t high) noexcept
+  {
+    return ((a | high) - (b & ~high)) ^ ((a ^ ~b) & high);
+  }
+} // namespace detail
+
+/// packs a record of several safe integers into a single 64 bit word
+/// field i occupies packable_traits<Pi>::packed_size bits starting at offset<i>, the first field in the lowest bits
+///
+/// besides tuples, records can be converted from and to a lane image: the native values of all fields
+/// stored back to back in a little endian word (i.e. the bytes of a struct of the fields' value types without padding)
+/// on x86-64 cpus with BMI2 the conversion between lane image and packed word is a single PDEP / PEXT
+/// plus a lane wise add / sub of the fields' minimums; the kernel is selected at startup and
+/// the portable shift / mask fallback produces bit identical results
+template<typename... Ps>
+class field_codec
+{
+  static_assert((detail::is_safe_v<Ps> && ...), "field_codec: fields must be safe integers");
+
+  using layout = detail::packed_layout<Ps...>;
+  static constexpr size_t count = sizeof...(Ps);
+
+  static_assert(layout::size <= detail::word_bits, "field_codec: fields must fit into a single word");
+
+  static constexpr size_t lane_sizes[count + 1U] = {sizeof(typename Ps::value_type)..., 0U};
+
+  static constexpr size_t lane_offset_of(size_t i) noexcept
+  {
+    size_t res{};
+    for(size_t j{}; j < i; ++j)
+    {
+      res += 8U * lane_sizes[j];
+    }
+    return res;
+  }
+
+public:
+  using value_type = std::tuple<Ps...>;
+
+  static constexpr size_t packed_size = layout::size;
+
+  /// bit offset of field I in the packed word
+  template<size_t I>
+  static constexpr size_t offset = layout::offset(I);
+
+  /// bit offset of field I in the lane image
+  template<size_t I>
+  static constexpr size_t lane_offset = lane_offset_of(I);
+
+  /// whether the native values of all fields fit into a single word lane image
+  static constexpr bool has_lanes = (lane_offset_of(count) <= detail::word_bits);
+
+private:
+  template<size_t I>
+  using field_type = std::tuple_element_t<I, value_type>;
+
+  template<size_t I>
+  using native_type = typename field_type<I>::value_type;
+
+  template<size_t I>
+  static constexpr uint64_t lane_mask = detail::low_mask(8U * sizeof(native_type<I>));
+
+  /// minimum of field I, truncated to its lane
+  template<size_t I>
+  static constexpr uint64_t lane_min = static_cast<uint64_t>(static_cast<native_type<I>>(std::numeric_limits<field_type<I>>::min())) & lane_mask<I>;
+
+  template<size_t... Is>
+  static constexpr uint64_t deposit_mask_impl(std::index_sequence<Is...>) noexcept
+  {
+    return (uint64_t{} | ... | detail::shl(detail::low_mask(layout::sizes[Is]), lane_offset<Is>));
+  }
+
+  template<size_t... Is>
+  static constexpr uint64_t lane_high_impl(std::index_sequence<Is...>) noexcept
+  {
+    return (uint64_t{} | ... | detail::shl(uint64_t{1U}, (lane_offset<Is> + (8U * sizeof(native_type<Is>))) - 1U));
+  }
+
+  template<size_t... Is>
+  static constexpr uint64_t lane_min_impl(std::index_sequence<Is...>) noexcept
+  {
+    return (uint64_t{} | ... | detail::shl(lane_min<Is>, lane_offset<Is>));
+  }
+
+  using indices = std::index_sequence_for<Ps...>;
+
+  /// bits of the lane image that receive packed bits
+  static constexpr uint64_t deposit_mask = deposit_mask_impl(indices{});
+  /// most significant bit of each lane
+  static constexpr uint64_t lane_high = lane_high_impl(indices{});
+  /// minimums of all fields in their lanes
+  static constexpr uint64_t lane_mins = lane_min_impl(indices{});
+
+  template<size_t I>
+  static constexpr uint64_t code(value_type const &v) noexcept
+  {
+    return static_cast<uint64_t>(static_cast<native_type<I>>(std::get<I>(v))) - lane_min<I>;
+  }
+
+  template<size_t... Is>
+  static constexpr uint64_t pack_impl(value_type const &v, std::index_sequence<Is...>) noexcept
+  {
+    return (uint64_t{} | ... | detail::shl(code<Is>(v) & detail::low_mask(layout::sizes[Is]), offset<Is>));
+  }
+
+  template<size_t... Is>
+  static constexpr value_type unpack_impl(uint64_t packed, std::index_sequence<Is...>) noexcept
+  {
+    return value_type{field_type<Is>{static_cast<native_type<Is>>((detail::shr(packed, offset<Is>) & detail::low_mask(layout::sizes[Is])) + lane_min<Is>), unchecked_construct}...};
+  }
+
+  template<size_t... Is>
+  static constexpr uint64_t to_lanes(value_type const &v, std::index_sequence<Is...>) noexcept
+  {
+    return (uint64_t{} | ... | detail::shl(static_cast<uint64_t>(static_cast<native_type<Is>>(std::get<Is>(v))) & lane_mask<Is>, lane_offset<Is>));
+  }
+
+  template<size_t... Is>
+  static constexpr value_type from_lanes(uint64_t lanes, std::index_sequence<Is...>) noexcept
+  {
+    return value_type{field_type<Is>{static_cast<native_type<Is>>(detail::shr(lanes, lane_offset<Is>) & lane_mask<Is>), unchecked_construct}...};
+  }
+
+  template<size_t... Is>
+  static constexpr uint64_t pack_lanes_impl(uint64_t lanes, std::index_sequence<Is...>) noexcept
+  {
+    return (uint64_t{} | ... | detail::shl(((detail::shr(lanes, lane_offset<Is>) - lane_min<Is>) & detail::low_mask(layout::sizes[Is])), offset<Is>));
+  }
+
+  template<size_t... Is>
+  static constexpr uint64_t unpack_lanes_impl(uint64_t packed, std::index_sequence<Is...>) noexcept
+  {
+    return (uint64_t{} | ... | detail::shl(((detail::shr(packed, offset<Is>) & detail::low_mask(layout::sizes[Is])) + lane_min<Is>) & lane_mask<Is>, lane_offset<Is>));
+  }
+
+public:
+  static uint64_t pack(Ps const &... fields) noexcept
+  {
+    return pack(value_type{fields...});
+  }
+
+  static uint64_t pack(value_type const &v) noexcept
+  {
+    if constexpr(has_lanes)
+    {
+      return pack_lanes(to_lanes(v, indices{}));
+    }
+    else
+    {
+      return pack_impl(v, indices{});
+    }
+  }
+
+  static value_type unpack(uint64_t packed) noexcept
+  {
+    if constexpr(has_lanes)
+    {
+      return from_lanes(unpack_lanes(packed), indices{});
+    }
+    else
+    {
+      return unpack_impl(packed, indices{});
+    }
+  }
+
+  /// packs a lane image
+  static uint64_t pack_lanes(uint64_t lanes) noexcept
+  {
+#ifdef RDK_X86_64
+    if(detail::cpu.bmi2)
+    {
+      return pack_lanes_bmi2(lanes);
+    }
+#endif
+    return pack_lanes_portable(lanes);
+  }
+
+  /// unpacks into a lane image
+  static uint64_t unpack_lanes(uint64_t packed) noexcept
+  {
+#ifdef RDK_X86_64
+    if(detail::cpu.bmi2)
+    {
+      return unpack_lanes_bmi2(packed);
+    }
+#endif
+    return unpack_lanes_portable(packed);
+  }
+
+  /// packs n lane images, selecting the kernel once for the whole batch
+  static void pack_lanes(uint64_t const *lanes, uint64_t *packed, size_t n) noexcept
+  {
+#ifdef RDK_X86_64
+    if(detail::cpu.bmi2)
+    {
+      pack_lanes_bmi2(lanes, packed, n);
+      return;
+    }
+#endif
+    for(size_t i{}; i < n; ++i)
+    {
+      packed[i] = pack_lanes_portable(lanes[i]);
+    }
+  }
+
+  /// unpacks n words into lane images, selecting the kernel once for the whole batch
+  static void unpack_lanes(uint64_t const *packed, uint64_t *lanes, size_t n) noexcept
+  {
+#ifdef RDK_X86_64
+    if(detail::cpu.bmi2)
+    {
+      unpack_lanes_bmi2(packed, lanes, n);
+      return;
+    }
+#endif
+    for(size_t i{}; i < n; ++i)
+    {
+      lanes[i] = unpack_lanes_portable(packed[i]);
+    }
+  }
+
+  // individual kernels; prefer the dispatching functions above
+
+  static constexpr uint64_t pack_lanes_portable(uint64_t lanes) noexcept
+  {
+    static_assert(has_lanes, "field_codec: native values don't fit into a single word");
+    return pack_lanes_impl(lanes, indices{});
+  }
+
+  static constexpr uint64_t unpack_lanes_portable(uint64_t packed) noexcept
+  {
+    static_assert(has_lanes, "field_codec: native values don't fit into a single word");
+    return unpack_lanes_impl(packed, indices{});
+  }
+
+#ifdef RDK_X86_64
+  RDK_TARGET("bmi2") static uint64_t pack_lanes_bmi2(uint64_t lanes) noexcept
+  {
+    static_assert(has_lanes, "field_codec: native values don't fit into a single word");
+    return _pext_u64(detail::swar_sub(lanes, lane_mins, lane_high), deposit_mask);
+  }
+
+  RDK_TARGET("bmi2") static uint64_t unpack_lanes_bmi2(uint64_t packed) noexcept
+  {
+    static_assert(has_lanes, "field_codec: native values don't fit into a single word");
+    return detail::swar_add(_pdep_u64(packed, deposit_mask), lane_mins, lane_high);
+  }
+
+  RDK_TARGET("bmi2") static void pack_lanes_bmi2(uint64_t const *lanes, uint64_t *packed, size_t n) noexcept
+  {
+    for(size_t i{}; i < n; ++i)
+    {
+      packed[i] = _pext_u64(detail::swar_sub(lanes[i], lane_mins, lane_high), deposit_mask);
+    }
+  }
+
+  RDK_TARGET("bmi2") static void unpack_lanes_bmi2(uint64_t const *packed, uint64_t *lanes, size_t n) noexcept
+  {
+    for(size_t i{}; i < n; ++i)
+    {
+      lanes[i] = detail::swar_add(_pdep_u64(packed[i], deposit_mask), lane_mins, lane_high);
+    }
+  }
+#endif
+};
+
+} // namespace rdk
+
+#endif // !RDK_DF8305255B864C3FB2C6937C356F6116
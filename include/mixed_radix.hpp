@@ -0,0 +1,231 @@
+#pragma once
+#ifndef RDK_4BA344F63A3642A6AF0E31CB97AFE166
+#define RDK_4BA344F63A3642A6AF0E31CB97AFE166
+
+#include "packer.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace rdk
+{
+
+/// opts a record (a tuple, pair or registered struct) into mixed radix packing
+/// instead of rounding every field up to a whole number of bits, consecutive fields are combined into a single integer
+/// in base max_code + 1 per field, e.g. five safe_unsigned<0, 2> take 8 bits (3^5 = 243) rather than 10
+/// fields are grouped greedily, a group ends when the next field would make it exceed 64 bits
+template<typename Record>
+class mixed_radix : public Record
+{
+public:
+  using record_type = Record;
+
+  constexpr mixed_radix(Record const &r)
+    : Record(r)
+  {
+  }
+
+  template<typename... Ts, typename = std::enable_if_t<(sizeof...(Ts) > 1U)>>
+  constexpr mixed_radix(Ts &&... fields)
+    : Record{std::forward<Ts>(fields)...}
+  {
+  }
+
+  constexpr Record const &record() const noexcept
+  {
+    return *this;
+  }
+};
+
+namespace detail
+{
+  /// grouping of count fields for mixed radix packing
+  template<size_t count>
+  struct radix_layout
+  {
+    size_t group_count{};
+    /// index of the first field of each group, first[group_count] == count
+    size_t first[count + 1U]{};
+    /// bit offset of each group, offset[group_count] is the packed size
+    size_t offset[count + 1U]{};
+  };
+
+  template<size_t count>
+  constexpr radix_layout<count> make_radix_layout(uint64_t const (&max_codes)[count + 1U]) noexcept
+  {
+    radix_layout<count> res{};
+    uint64_t group_max{};
+    for(size_t i{}; i < count; ++i)
+    {
+      uint64_t const m = max_codes[i];
+      // the group's largest value becomes group_max * (m + 1) + m, which must fit into a word
+      // a full group is closed even for m == 0, so whole word fields always end their group and are never divided by
+      bool const fits = (group_max < ~uint64_t{}) && ((0U == group_max) || ((m < ~uint64_t{}) && (group_max <= ((~uint64_t{} - m) / (m + 1U)))));
+      if((0U == i) || !fits)
+      {
+        if(0U != i)
+        {
+          res.offset[res.group_count + 1U] = res.offset[res.group_count] + bit_width(group_max);
+          ++res.group_count;
+        }
+        res.first[res.group_count] = i;
+        group_max = m;
+      }
+      else
+      {
+        group_max = (group_max * (m + 1U)) + m;
+      }
+    }
+    if(0U != count)
+    {
+      res.offset[res.group_count + 1U] = res.offset[res.group_count] + bit_width(group_max);
+      ++res.group_count;
+    }
+    res.first[res.group_count] = count;
+    return res;
+  }
+
+  template<typename Record, typename Fields, typename FieldTypes>
+  struct mixed_radix_traits;
+
+  template<typename Record, typename Fields, typename... Ps>
+  struct mixed_radix_traits<Record, Fields, std::tuple<Ps...>>
+  {
+    static_assert(((packable_traits<Ps>::packed_size <= word_bits) && ...), "mixed_radix: fields must not exceed 64 bits");
+
+  private:
+    static constexpr size_t count = sizeof...(Ps);
+    static constexpr uint64_t max_codes[count + 1U] = {max_code_v<Ps>..., 0U};
+    static constexpr radix_layout<count> layout = make_radix_layout<count>(max_codes);
+
+  public:
+    static constexpr uintmax_t packed_size = layout.offset[layout.group_count];
+    using value_type = mixed_radix<Record>;
+    using packed_type = bitstream<packed_size>;
+
+  private:
+    static constexpr bool nothrow_pack = (noexcept(packable_traits<Ps>::pack(std::declval<Ps const &>())) && ...);
+    static constexpr bool nothrow_unpack = (noexcept(packable_traits<Ps>::unpack(std::declval<typename packable_traits<Ps>::packed_type const &>())) && ...);
+
+    static constexpr size_t group_of(size_t i) noexcept
+    {
+      size_t g{};
+      while(layout.first[g + 1U] <= i)
+      {
+        ++g;
+      }
+      return g;
+    }
+
+    template<size_t I>
+    using field_traits = packable_traits<std::tuple_element_t<I, std::tuple<Ps...>>>;
+
+    template<size_t... Is>
+    static constexpr void codes_of(mixed_radix<Record> const &v, uint64_t *codes, std::index_sequence<Is...>) noexcept(nothrow_pack)
+    {
+      ((codes[Is] = field_traits<Is>::pack(Fields::template get<Is>(v)).extract(0U, field_traits<Is>::packed_size)), ...);
+    }
+
+    template<size_t I>
+    static constexpr auto field_of(uint64_t const *codes) noexcept(nothrow_unpack)
+    {
+      return field_traits<I>::unpack(typename field_traits<I>::packed_type{codes[I]});
+    }
+
+    /// recovers the code of field I from the remaining value acc of its group
+    template<size_t I>
+    static constexpr void decode_field(packed_type const &v, uint64_t &acc, uint64_t *codes) noexcept
+    {
+      constexpr size_t g = group_of(I);
+      if constexpr(layout.first[g] == I)
+      {
+        acc = v.extract(layout.offset[g], layout.offset[g + 1U] - layout.offset[g]);
+      }
+      if constexpr(layout.first[g + 1U] == (I + 1U))
+      {
+        codes[I] = acc;
+      }
+      else
+      {
+        // never a whole word field, those are alone in their group
+        constexpr divider radix{max_codes[I] + 1U};
+        uint64_t const q = radix.divide(acc);
+        codes[I] = acc - (q * (max_codes[I] + 1U));
+        acc = q;
+      }
+    }
+
+    template<size_t... Is>
+    static constexpr void decode(packed_type const &v, uint64_t *codes, std::index_sequence<Is...>) noexcept
+    {
+      uint64_t acc{};
+      (decode_field<Is>(v, acc, codes), ...);
+    }
+
+    template<size_t... Is>
+    static constexpr mixed_radix<Record> make(uint64_t const *codes, std::index_sequence<Is...>)
+    {
+      return mixed_radix<Record>{Fields::make(field_of<Is>(codes)...)};
+    }
+
+    using indices = std::index_sequence_for<Ps...>;
+
+  public:
+    /// number of groups, each taking a whole number of bits
+    static constexpr size_t group_count = layout.group_count;
+
+    static constexpr packed_type pack(value_type const &v) noexcept(nothrow_pack)
+    {
+      uint64_t codes[count + 1U]{};
+      codes_of(v, codes, indices{});
+
+      packed_type res;
+      for(size_t g{}; g < layout.group_count; ++g)
+      {
+        // the group's first field ends up least significant
+        uint64_t acc{};
+        for(size_t i = layout.first[g + 1U]; i-- > layout.first[g];)
+        {
+          acc = (acc * (max_codes[i] + 1U)) + codes[i];
+        }
+        res.insert(layout.offset[g], layout.offset[g + 1U] - layout.offset[g], acc);
+      }
+      return res;
+    }
+
+    static constexpr value_type unpack(packed_type const &v) noexcept(nothrow_unpack)
+    {
+      uint64_t codes[count + 1U]{};
+      decode(v, codes, indices{});
+      return make(codes, indices{});
+    }
+
+    static void pack_into(std::byte *base, size_t bit_offset, value_type const &v) noexcept(nothrow_pack)
+    {
+      store_bitstream(base, bit_offset, pack(v));
+    }
+
+    static value_type unpack_from(std::byte const *base, size_t bit_offset) noexcept(nothrow_unpack)
+    {
+      return unpack(load_bitstream<packed_size>(base, bit_offset));
+    }
+  };
+} // namespace detail
+
+template<typename Record>
+struct is_packable<mixed_radix<Record>> : is_packable<Record>
+{
+};
+
+template<typename Record>
+struct packable_traits<mixed_radix<Record>>
+  : detail::mixed_radix_traits<Record, typename packable_traits<Record>::fields, typename packable_traits<Record>::field_types>
+{
+};
+
+} // namespace rdk
+
+#endif // !RDK_4BA344F63A3642A6AF0E31CB97AFE166
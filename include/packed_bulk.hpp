@@ -0,0 +1,456 @@
+#pragma once
+#ifndef RDK_7BB8E7B5E48749069DDC38682AD13B40
+#define RDK_7BB8E7B5E48749069DDC38682AD13B40
+
+#include "cpu_features.hpp"
+#include "packed_vector.hpp"
+#include "packer.hpp"
+#include "safe_int.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace rdk
+{
+
+// bulk kernels
+// each kernel is specialized at compile time on the element type, i.e. on its packed size and minimum
+// vector kernels process as many elements as they can without reading past the spanned words
+// and return how many that were; the scalar kernels take care of the rest
+namespace detail
+{
+  template<typename S>
+  struct bulk_element
+  {
+    static_assert(is_safe_v<S>, "bulk: elements must be safe integers");
+    static_assert(std::is_trivially_copyable_v<S> && (sizeof(S) == sizeof(typename S::value_type)), "bulk: safe integers must be layout compatible with their value type");
+    static_assert(sizeof(typename S::value_type) <= sizeof(uint64_t), "bulk: elements must be stored in at most 64 bits");
+
+    using native_type = typename S::value_type;
+    static constexpr size_t width = packable_traits<S>::packed_size;
+    static constexpr uint64_t mask = low_mask(width);
+    /// minimum as a 64 bit pattern, adding it to a code and truncating to the native type yields the value
+    static constexpr uint64_t min = static_cast<uint64_t>(static_cast<native_type>(std::numeric_limits<S>::min()));
+  };
+
+  template<typename S>
+  void unpack_bulk_scalar(uint64_t const *words, size_t first, S *out, size_t n) noexcept
+  {
+    using element = bulk_element<S>;
+    for(size_t i{}; i < n; ++i)
+    {
+      uint64_t const code = (0U == element::width) ? 0U : extract_bits(words, (first + i) * element::width, element::width);
+      out[i] = S{static_cast<typename element::native_type>(element::min + code), unchecked_construct};
+    }
+  }
+
+#ifdef RDK_X86_64
+  /// stores the low sizeof(T) bytes of each 64 bit lane
+  template<typename T>
+  RDK_TARGET("avx2") void store_lanes_avx2(void *out, __m256i v) noexcept
+  {
+    if constexpr(8U == sizeof(T))
+    {
+      _mm256_storeu_si256(static_cast<__m256i *>(out), v);
+    }
+    else
+    {
+      __m128i const dwords = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6)));
+      if constexpr(4U == sizeof(T))
+      {
+        _mm_storeu_si128(static_cast<__m128i *>(out), dwords);
+      }
+      else if constexpr(2U == sizeof(T))
+      {
+        _mm_storel_epi64(static_cast<__m128i *>(out), _mm_shuffle_epi8(dwords, _mm_setr_epi8(0, 1, 4, 5, 8, 9, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1)));
+      }
+      else
+      {
+        int32_t const bytes = _mm_cvtsi128_si32(_mm_shuffle_epi8(dwords, _mm_setr_epi8(0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1)));
+        std::memcpy(out, &bytes, sizeof(bytes));
+      }
+    }
+  }
+
+  /// 4 elements per iteration: gather the 64 bits following each element's first byte (or its two words
+  /// for elements wider than 57 bits, which can span 9 bytes), shift the element down, mask it and add the minimum
+  template<typename S>
+  RDK_TARGET("avx2") size_t unpack_bulk_avx2(uint64_t const *words, size_t word_count, size_t first, S *out, size_t n) noexcept
+  {
+    using element = bulk_element<S>;
+    constexpr size_t width = element::width;
+    constexpr size_t lanes = 4U;
+    auto const *base = reinterpret_cast<long long const *>(words);
+
+    __m256i pos = _mm256_setr_epi64x(
+        static_cast<long long>(first * width)
+      , static_cast<long long>((first + 1U) * width)
+      , static_cast<long long>((first + 2U) * width)
+      , static_cast<long long>((first + 3U) * width));
+    __m256i const step = _mm256_set1_epi64x(static_cast<long long>(lanes * width));
+    __m256i const mask = _mm256_set1_epi64x(static_cast<long long>(element::mask));
+    __m256i const min = _mm256_set1_epi64x(static_cast<long long>(element::min));
+
+    size_t i{};
+    if constexpr(width <= 57U)
+    {
+      for(; ((i + lanes) <= n) && (((((first + i + lanes) - 1U) * width) / 8U) + 8U <= (8U * word_count)); i += lanes)
+      {
+        __m256i v = _mm256_i64gather_epi64(base, _mm256_srli_epi64(pos, 3), 1);
+        v = _mm256_srlv_epi64(v, _mm256_and_si256(pos, _mm256_set1_epi64x(7)));
+        v = _mm256_add_epi64(_mm256_and_si256(v, mask), min);
+        store_lanes_avx2<typename element::native_type>(out + i, v);
+        pos = _mm256_add_epi64(pos, step);
+      }
+    }
+    else
+    {
+      for(; ((i + lanes) <= n) && ((((((first + i + lanes) - 1U) * width) / word_bits) + 1U) < word_count); i += lanes)
+      {
+        __m256i const index = _mm256_srli_epi64(pos, 6);
+        __m256i const shift = _mm256_and_si256(pos, _mm256_set1_epi64x(63));
+        __m256i const lo = _mm256_i64gather_epi64(base, index, 8);
+        __m256i const hi = _mm256_i64gather_epi64(base, _mm256_add_epi64(index, _mm256_set1_epi64x(1)), 8);
+        // shifting left by 64 yields zero, which is exactly what's needed for elements that start at a word boundary
+        __m256i v = _mm256_or_si256(_mm256_srlv_epi64(lo, shift), _mm256_sllv_epi64(hi, _mm256_sub_epi64(_mm256_set1_epi64x(64), shift)));
+        v = _mm256_add_epi64(_mm256_and_si256(v, mask), min);
+        store_lanes_avx2<typename element::native_type>(out + i, v);
+        pos = _mm256_add_epi64(pos, step);
+      }
+    }
+    return i;
+  }
+
+  /// the unmasked AVX-512 intrinsics merge into an undefined vector, which GCC reports as maybe uninitialized;
+  /// their zero masking forms with every lane selected compile to the same instructions
+  constexpr __mmask8 all_lanes_avx512 = 0xFF;
+
+  /// stores the low sizeof(T) bytes of each 64 bit lane
+  template<typename T>
+  RDK_TARGET("avx512f") void store_lanes_avx512(void *out, __m512i v) noexcept
+  {
+    if constexpr(8U == sizeof(T))
+    {
+      _mm512_storeu_si512(out, v);
+    }
+    else if constexpr(4U == sizeof(T))
+    {
+      _mm512_mask_cvtepi64_storeu_epi32(out, all_lanes_avx512, v);
+    }
+    else if constexpr(2U == sizeof(T))
+    {
+      _mm512_mask_cvtepi64_storeu_epi16(out, all_lanes_avx512, v);
+    }
+    else
+    {
+      _mm512_mask_cvtepi64_storeu_epi8(out, all_lanes_avx512, v);
+    }
+  }
+
+  /// same as the AVX2 kernel, 8 elements per iteration
+  template<typename S>
+  RDK_TARGET("avx512f") size_t unpack_bulk_avx512(uint64_t const *words, size_t word_count, size_t first, S *out, size_t n) noexcept
+  {
+    using element = bulk_element<S>;
+    constexpr size_t width = element::width;
+    constexpr size_t lanes = 8U;
+
+    __m512i pos = _mm512_add_epi64(
+        _mm512_set1_epi64(static_cast<long long>(first * width))
+      , _mm512_setr_epi64(0, width, 2 * width, 3 * width, 4 * width, 5 * width, 6 * width, 7 * width));
+    __m512i const step = _mm512_set1_epi64(static_cast<long long>(lanes * width));
+    __m512i const mask = _mm512_set1_epi64(static_cast<long long>(element::mask));
+    __m512i const min = _mm512_set1_epi64(static_cast<long long>(element::min));
+
+    size_t i{};
+    if constexpr(width <= 57U)
+    {
+      for(; ((i + lanes) <= n) && (((((first + i + lanes) - 1U) * width) / 8U) + 8U <= (8U * word_count)); i += lanes)
+      {
+        __m512i v = _mm512_mask_i64gather_epi64(_mm512_setzero_si512(), all_lanes_avx512, _mm512_maskz_srli_epi64(all_lanes_avx512, pos, 3), words, 1);
+        v = _mm512_maskz_srlv_epi64(all_lanes_avx512, v, _mm512_and_si512(pos, _mm512_set1_epi64(7)));
+        v = _mm512_add_epi64(_mm512_and_si512(v, mask), min);
+        store_lanes_avx512<typename element::native_type>(out + i, v);
+        pos = _mm512_add_epi64(pos, step);
+      }
+    }
+    else
+    {
+      for(; ((i + lanes) <= n) && ((((((first + i + lanes) - 1U) * width) / word_bits) + 1U) < word_count); i += lanes)
+      {
+        __m512i const index = _mm512_maskz_srli_epi64(all_lanes_avx512, pos, 6);
+        __m512i const shift = _mm512_and_si512(pos, _mm512_set1_epi64(63));
+        __m512i const lo = _mm512_mask_i64gather_epi64(_mm512_setzero_si512(), all_lanes_avx512, index, words, 8);
+        __m512i const hi = _mm512_mask_i64gather_epi64(_mm512_setzero_si512(), all_lanes_avx512, _mm512_add_epi64(index, _mm512_set1_epi64(1)), words, 8);
+        __m512i v = _mm512_or_si512(_mm512_maskz_srlv_epi64(all_lanes_avx512, lo, shift), _mm512_maskz_sllv_epi64(all_lanes_avx512, hi, _mm512_sub_epi64(_mm512_set1_epi64(64), shift)));
+        v = _mm512_add_epi64(_mm512_and_si512(v, mask), min);
+        store_lanes_avx512<typename element::native_type>(out + i, v);
+        pos = _mm512_add_epi64(pos, step);
+      }
+    }
+    return i;
+  }
+#endif
+
+  /// number of elements packed at a time; a block of them fills exactly packed_size words
+  constexpr size_t pack_block_size = word_bits;
+
+  template<size_t width, size_t i>
+  inline void pack_block_element(uint64_t const *codes, uint64_t *out, uint64_t &acc) noexcept
+  {
+    constexpr size_t shift = (i * width) % word_bits;
+    acc |= codes[i] << shift;
+    if constexpr((shift + width) >= word_bits)
+    {
+      out[(i * width) / word_bits] = acc;
+      if constexpr(0U == shift)
+      {
+        acc = 0U;
+      }
+      else
+      {
+        acc = codes[i] >> (word_bits - shift);
+      }
+    }
+  }
+
+  /// packs a block of codes (each already masked to width bits) into width words
+  /// fully unrolled, so every shift amount and word index is a compile time constant
+  template<size_t width, size_t... Is>
+  inline void pack_block(uint64_t const *codes, uint64_t *out, std::index_sequence<Is...>) noexcept
+  {
+    uint64_t acc{};
+    (pack_block_element<width, Is>(codes, out, acc), ...);
+  }
+
+  template<size_t width>
+  inline void pack_block(uint64_t const *codes, uint64_t *out) noexcept
+  {
+    pack_block<width>(codes, out, std::make_index_sequence<pack_block_size>{});
+  }
+
+  /// code of a value, which is either a safe integer of type S or its native value
+  template<typename S, typename E>
+  constexpr uint64_t bulk_code(E const &v) noexcept
+  {
+    using element = bulk_element<S>;
+    return (static_cast<uint64_t>(static_cast<typename element::native_type>(v)) - element::min) & element::mask;
+  }
+
+  template<typename S, typename E>
+  void pack_bulk_scalar(E const *in, size_t blocks, uint64_t *out) noexcept
+  {
+    using element = bulk_element<S>;
+    uint64_t codes[pack_block_size];
+    for(size_t b{}; b < blocks; ++b, in += pack_block_size, out += element::width)
+    {
+      for(size_t i{}; i < pack_block_size; ++i)
+      {
+        codes[i] = bulk_code<S>(in[i]);
+      }
+      pack_block<element::width>(codes, out);
+    }
+  }
+
+  /// packs the last n (< block size) elements, clearing the unused bits of the last word
+  template<typename S, typename E>
+  void pack_bulk_tail(E const *in, size_t n, uint64_t *out) noexcept
+  {
+    using element = bulk_element<S>;
+    uint64_t codes[pack_block_size]{};
+    for(size_t i{}; i < n; ++i)
+    {
+      codes[i] = bulk_code<S>(in[i]);
+    }
+    uint64_t block[(0U != element::width) ? element::width : 1U];
+    pack_block<element::width>(codes, block);
+    std::memcpy(out, block, sizeof(uint64_t) * (((n * element::width) + (word_bits - 1U)) / word_bits));
+  }
+
+#ifdef RDK_X86_64
+  /// loads 4 native values of type T, zero extended to 64 bit lanes
+  template<typename T>
+  RDK_TARGET("avx2") __m256i load_lanes_avx2(void const *in) noexcept
+  {
+    if constexpr(8U == sizeof(T))
+    {
+      return _mm256_loadu_si256(static_cast<__m256i const *>(in));
+    }
+    else if constexpr(4U == sizeof(T))
+    {
+      return _mm256_cvtepu32_epi64(_mm_loadu_si128(static_cast<__m128i const *>(in)));
+    }
+    else if constexpr(2U == sizeof(T))
+    {
+      return _mm256_cvtepu16_epi64(_mm_loadl_epi64(static_cast<__m128i const *>(in)));
+    }
+    else
+    {
+      int32_t bytes;
+      std::memcpy(&bytes, in, sizeof(bytes));
+      return _mm256_cvtepu8_epi64(_mm_cvtsi32_si128(bytes));
+    }
+  }
+
+  /// rebases and masks a block 4 elements at a time, then packs it
+  /// the codes only depend on the low packed_size bits of each value, so zero extension works for signed types as well
+  template<typename S, typename E>
+  RDK_TARGET("avx2") void pack_bulk_avx2(E const *in, size_t blocks, uint64_t *out) noexcept
+  {
+    using element = bulk_element<S>;
+    __m256i const mask = _mm256_set1_epi64x(static_cast<long long>(element::mask));
+    __m256i const min = _mm256_set1_epi64x(static_cast<long long>(element::min));
+    alignas(32) uint64_t codes[pack_block_size];
+    for(size_t b{}; b < blocks; ++b, in += pack_block_size, out += element::width)
+    {
+      for(size_t i{}; i < pack_block_size; i += 4U)
+      {
+        __m256i const v = load_lanes_avx2<typename element::native_type>(in + i);
+        _mm256_store_si256(reinterpret_cast<__m256i *>(codes + i), _mm256_and_si256(_mm256_sub_epi64(v, min), mask));
+      }
+      pack_block<element::width>(codes, out);
+    }
+  }
+
+  /// loads 8 native values of type T, zero extended to 64 bit lanes
+  template<typename T>
+  RDK_TARGET("avx512f") __m512i load_lanes_avx512(void const *in) noexcept
+  {
+    if constexpr(8U == sizeof(T))
+    {
+      return _mm512_loadu_si512(in);
+    }
+    else if constexpr(4U == sizeof(T))
+    {
+      return _mm512_maskz_cvtepu32_epi64(all_lanes_avx512, _mm256_loadu_si256(static_cast<__m256i const *>(in)));
+    }
+    else if constexpr(2U == sizeof(T))
+    {
+      return _mm512_maskz_cvtepu16_epi64(all_lanes_avx512, _mm_loadu_si128(static_cast<__m128i const *>(in)));
+    }
+    else
+    {
+      return _mm512_maskz_cvtepu8_epi64(all_lanes_avx512, _mm_loadl_epi64(static_cast<__m128i const *>(in)));
+    }
+  }
+
+  /// same as the AVX2 kernel, 8 elements at a time
+  template<typename S, typename E>
+  RDK_TARGET("avx512f") void pack_bulk_avx512(E const *in, size_t blocks, uint64_t *out) noexcept
+  {
+    using element = bulk_element<S>;
+    __m512i const mask = _mm512_set1_epi64(static_cast<long long>(element::mask));
+    __m512i const min = _mm512_set1_epi64(static_cast<long long>(element::min));
+    alignas(64) uint64_t codes[pack_block_size];
+    for(size_t b{}; b < blocks; ++b, in += pack_block_size, out += element::width)
+    {
+      for(size_t i{}; i < pack_block_size; i += 8U)
+      {
+        __m512i const v = load_lanes_avx512<typename element::native_type>(in + i);
+        _mm512_store_si512(codes + i, _mm512_and_si512(_mm512_sub_epi64(v, min), mask));
+      }
+      pack_block<element::width>(codes, out);
+    }
+  }
+#endif
+
+  template<typename S, typename E>
+  void pack_bulk(E const *in, size_t n, uint64_t *out) noexcept
+  {
+    using element = bulk_element<S>;
+    if constexpr(0U != element::width)
+    {
+      size_t const blocks = n / pack_block_size;
+#ifdef RDK_X86_64
+      if(detail::cpu.avx512f)
+      {
+        pack_bulk_avx512<S>(in, blocks, out);
+      }
+      else if(detail::cpu.avx2)
+      {
+        pack_bulk_avx2<S>(in, blocks, out);
+      }
+      else
+#endif
+      {
+        pack_bulk_scalar<S>(in, blocks, out);
+      }
+      pack_bulk_tail<S>(in + (blocks * pack_block_size), n % pack_block_size, out + (blocks * element::width));
+    }
+  }
+} // namespace detail
+
+/// unpacks the first n elements of a packed span into native safe integers
+/// rebasing by the minimum happens in the same pass and no per element range check is done,
+/// since every code of a packed span is in range by construction
+template<typename T, T min, T max, typename P>
+void unpack_bulk(packed_span<safe<T, min, max, P>> in, safe<T, min, max, P> *out, size_t n) noexcept
+{
+  using S = safe<T, min, max, P>;
+  assert(n <= in.size());
+  size_t done{};
+  if constexpr(0U != detail::bulk_element<S>::width)
+  {
+#ifdef RDK_X86_64
+    if(detail::cpu.avx512f)
+    {
+      done = detail::unpack_bulk_avx512(in.data(), in.word_count(), in.offset(), out, n);
+    }
+    else if(detail::cpu.avx2)
+    {
+      done = detail::unpack_bulk_avx2(in.data(), in.word_count(), in.offset(), out, n);
+    }
+#endif
+  }
+  detail::unpack_bulk_scalar(in.data(), in.offset() + done, out + done, n - done);
+}
+
+/// packs n safe integers into (n * packed_size + 63) / 64 words
+/// element i occupies bits [i * packed_size, (i + 1) * packed_size), i.e. the output is bit identical
+/// to repeated pack_into calls (or a packed_vector of the same values); unused bits of the last word are cleared
+template<typename T, T min, T max, typename P>
+void pack_bulk(safe<T, min, max, P> const *in, size_t n, uint64_t *out) noexcept
+{
+  detail::pack_bulk<safe<T, min, max, P>>(in, n, out);
+}
+
+/// packs n native values known to be in the range of S
+template<typename S>
+void pack_bulk(typename S::value_type const *in, size_t n, uint64_t *out, unchecked_construct_t) noexcept
+{
+  assert(std::all_of(in, in + n, [](auto v) { return (v >= static_cast<typename S::value_type>(std::numeric_limits<S>::min())) && (v <= static_cast<typename S::value_type>(std::numeric_limits<S>::max())); }));
+  detail::pack_bulk<S>(in, n, out);
+}
+
+/// packs n native values into the packed representation of S
+/// throws std::domain_error without writing anything if any value is out of range
+template<typename S>
+void pack_bulk(typename S::value_type const *in, size_t n, uint64_t *out)
+{
+  using value_type = typename S::value_type;
+  constexpr auto lo = static_cast<value_type>(std::numeric_limits<S>::min());
+  constexpr auto hi = static_cast<value_type>(std::numeric_limits<S>::max());
+
+  // branch free, so the check vectorizes
+  bool bad = false;
+  for(size_t i{}; i < n; ++i)
+  {
+    bad |= ((in[i] < lo) | (in[i] > hi));
+  }
+  if(bad)
+  {
+    detail::raise<std::domain_error>("SafeInt: value exceeds specified range.");
+  }
+  detail::pack_bulk<S>(in, n, out);
+}
+
+} // namespace rdk
+
+#endif // !RDK_7BB8E7B5E48749069DDC38682AD13B40
@@ -0,0 +1,130 @@
+#pragma once
+#ifndef RDK_12F8CC9BE02445079EE82C7CF4C888CA
+#define RDK_12F8CC9BE02445079EE82C7CF4C888CA
+
+#include "packer.hpp"
+#include "safe_int.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+namespace rdk
+{
+
+/// declares the values of enum E to lie within [first, last]
+/// packing checks the range and throws std::domain_error for values outside of it
+template<typename E, E first, E last>
+struct enum_range
+{
+  static_assert(std::is_enum_v<E>, "enum_range: type must be an enum");
+  static_assert(static_cast<std::underlying_type_t<E>>(first) <= static_cast<std::underlying_type_t<E>>(last), "enum_range: first must not exceed last");
+
+  /// safe integer covering the underlying values, its packable_traits determine the packed representation
+  using range_type = safe<std::underlying_type_t<E>, static_cast<std::underlying_type_t<E>>(first), static_cast<std::underlying_type_t<E>>(last)>;
+  static constexpr bool checked = true;
+};
+
+/// same as enum_range, for enums whose values are known to always be within [first, last]
+/// packing doesn't check the range (other than by assertion)
+template<typename E, E first, E last>
+struct dense_enum_range : enum_range<E, first, last>
+{
+  static constexpr bool checked = false;
+};
+
+/// registers enum E as packable by deriving from enum_range or dense_enum_range
+///
+///   enum class color { red, green, blue };
+///   template<> struct rdk::enum_traits<color> : rdk::dense_enum_range<color, color::red, color::blue> {};
+template<typename E>
+struct enum_traits
+{
+};
+
+namespace detail
+{
+  template<typename E>
+  struct enum_packable_traits
+  {
+  private:
+    using range_type = typename enum_traits<E>::range_type;
+    using range_traits = packable_traits<range_type>;
+    using underlying_type = typename range_type::value_type;
+    static constexpr bool checked = enum_traits<E>::checked;
+
+    static constexpr range_type to_range(E v) noexcept(!checked)
+    {
+      auto const u = static_cast<underlying_type>(v);
+      bool const in_range = (u >= static_cast<underlying_type>(std::numeric_limits<range_type>::min())) && (u <= static_cast<underlying_type>(std::numeric_limits<range_type>::max()));
+      if constexpr(checked)
+      {
+        if(!in_range)
+        {
+          detail::raise<std::domain_error>("enum_range: value exceeds declared range.");
+        }
+      }
+      else
+      {
+        assert(in_range);
+      }
+      return range_type{u, unchecked_construct};
+    }
+
+  public:
+    static constexpr uintmax_t packed_size = range_traits::packed_size;
+    using value_type = E;
+    using packed_type = typename range_traits::packed_type;
+
+    static constexpr uint64_t max_code = range_traits::max_code;
+    static constexpr bool has_niche = range_traits::has_niche;
+
+    static constexpr packed_type niche() noexcept
+    {
+      return range_traits::niche();
+    }
+
+    static constexpr bool is_niche(packed_type const &v) noexcept
+    {
+      return range_traits::is_niche(v);
+    }
+
+    static constexpr packed_type pack(value_type v) noexcept(!checked)
+    {
+      return range_traits::pack(to_range(v));
+    }
+
+    static constexpr value_type unpack(packed_type const &v) noexcept
+    {
+      return static_cast<E>(static_cast<underlying_type>(range_traits::unpack(v)));
+    }
+
+    static void pack_into(std::byte *base, size_t bit_offset, value_type v) noexcept(!checked)
+    {
+      range_traits::pack_into(base, bit_offset, to_range(v));
+    }
+
+    static value_type unpack_from(std::byte const *base, size_t bit_offset) noexcept
+    {
+      return static_cast<E>(static_cast<underlying_type>(range_traits::unpack_from(base, bit_offset)));
+    }
+  };
+} // namespace detail
+
+template<typename E>
+struct is_packable<E, std::void_t<typename enum_traits<E>::range_type>> : std::true_type
+{
+};
+
+template<typename E>
+struct packable_traits<E, std::void_t<typename enum_traits<E>::range_type>>
+  : detail::enum_packable_traits<E>
+{
+};
+
+} // namespace rdk
+
+#endif // !RDK_12F8CC9BE02445079EE82C7CF4C888CA
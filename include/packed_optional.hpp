@@ -0,0 +1,80 @@
+#pragma once
+#ifndef RDK_BD3429B5A0644BE294FA94999ECBFDE5
+#define RDK_BD3429B5A0644BE294FA94999ECBFDE5
+
+#include "packer.hpp"
+
+#include <cstddef>
+#include <optional>
+#include <type_traits>
+
+namespace rdk
+{
+
+template<typename P>
+struct is_packable<std::optional<P>> : is_packable<P>
+{
+};
+
+/// an optional is packed as its value alone if the value's packed representation has a niche, which then marks nullopt
+/// otherwise a presence bit is stored in the lowest bit, followed by the value (all zeros for nullopt)
+template<typename P>
+struct packable_traits<std::optional<P>>
+{
+private:
+  using traits = packable_traits<P>;
+  static constexpr bool nothrow_pack = noexcept(traits::pack(std::declval<P const &>()));
+  static constexpr bool nothrow_unpack = noexcept(traits::unpack(std::declval<typename traits::packed_type const &>()));
+
+public:
+  /// whether nullopt is stored in the niche of P rather than in a presence bit
+  static constexpr bool uses_niche = detail::has_niche_v<P>;
+
+  static constexpr uintmax_t packed_size = traits::packed_size + (uses_niche ? 0U : 1U);
+  using value_type = std::optional<P>;
+  using packed_type = bitstream<packed_size>;
+
+  static constexpr packed_type pack(value_type const &v) noexcept(nothrow_pack)
+  {
+    if constexpr(uses_niche)
+    {
+      return v ? traits::pack(*v) : traits::niche();
+    }
+    else
+    {
+      packed_type res;
+      if(v)
+      {
+        res.insert(0U, 1U, 1U);
+        res.insert(1U, traits::pack(*v));
+      }
+      return res;
+    }
+  }
+
+  static constexpr value_type unpack(packed_type const &v) noexcept(nothrow_unpack)
+  {
+    if constexpr(uses_niche)
+    {
+      return traits::is_niche(v) ? value_type{} : value_type{traits::unpack(v)};
+    }
+    else
+    {
+      return (0U != v.extract(0U, 1U)) ? value_type{traits::unpack(v.template extract<traits::packed_size>(1U))} : value_type{};
+    }
+  }
+
+  static void pack_into(std::byte *base, size_t bit_offset, value_type const &v) noexcept(nothrow_pack)
+  {
+    detail::store_bitstream(base, bit_offset, pack(v));
+  }
+
+  static value_type unpack_from(std::byte const *base, size_t bit_offset) noexcept(nothrow_unpack)
+  {
+    return unpack(detail::load_bitstream<packed_size>(base, bit_offset));
+  }
+};
+
+} // namespace rdk
+
+#endif // !RDK_BD3429B5A0644BE294FA94999ECBFDE5
@@ -0,0 +1,114 @@
+#pragma once
+#ifndef RDK_A831E49A9BC94659BA59F93F7A27B938
+#define RDK_A831E49A9BC94659BA59F93F7A27B938
+
+#include "packer.hpp"
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace rdk
+{
+
+/// list of pointers to the members of a record, see packable_fields
+template<auto... Members>
+struct packed_fields
+{
+};
+
+/// registers an aggregate as packable by deriving from packed_fields
+///
+///   struct point { safe_signed<-100, 100> x; safe_signed<-100, 100> y; };
+///   template<> struct rdk::packable_fields<point> : rdk::packed_fields<&point::x, &point::y> {};
+///
+/// members must all be packable and be listed in declaration order, since records are unpacked by aggregate initialization
+/// they're packed back to back like the fields of a tuple, the first listed member in the lowest bits
+template<typename T>
+struct packable_fields
+{
+};
+
+namespace detail
+{
+  template<typename M>
+  struct member_pointer_traits;
+
+  template<typename C, typename F>
+  struct member_pointer_traits<F C::*>
+  {
+    using class_type = C;
+    using field_type = F;
+  };
+
+  template<auto M>
+  using member_type_t = std::remove_cv_t<typename member_pointer_traits<decltype(M)>::field_type>;
+
+  template<size_t I, auto M, auto... Ms>
+  constexpr auto nth_member() noexcept
+  {
+    if constexpr(0U == I)
+    {
+      return M;
+    }
+    else
+    {
+      return nth_member<I - 1U, Ms...>();
+    }
+  }
+
+  /// field access for registered aggregates
+  template<typename T, auto... Members>
+  struct struct_fields
+  {
+    using value_type = T;
+
+    template<size_t I>
+    static constexpr auto const &get(T const &v) noexcept
+    {
+      return v.*nth_member<I, Members...>();
+    }
+
+    template<typename... Ts>
+    static constexpr T make(Ts &&... fields)
+    {
+      return T{std::forward<Ts>(fields)...};
+    }
+  };
+
+  // only declared, recovers the member list from a packable_fields specialization
+  template<auto... Members>
+  packed_fields<Members...> registered_fields(packed_fields<Members...> const &);
+
+  template<typename T>
+  using registered_fields_t = decltype(registered_fields(std::declval<packable_fields<T> const &>()));
+
+  template<typename T, typename Fields>
+  struct struct_packable;
+
+  template<typename T, auto... Members>
+  struct struct_packable<T, packed_fields<Members...>>
+  {
+    static_assert((std::is_same_v<typename member_pointer_traits<decltype(Members)>::class_type, T> && ...), "packed_fields: members must belong to the registered type");
+    static_assert(std::is_aggregate_v<T>, "packed_fields: registered type must be an aggregate");
+
+    static constexpr bool value = (is_packable_v<member_type_t<Members>> && ...);
+    using traits = composite_packable_traits<struct_fields<T, Members...>, member_type_t<Members>...>;
+  };
+} // namespace detail
+
+template<typename T>
+struct is_packable<T, std::void_t<detail::registered_fields_t<T>>>
+  : std::bool_constant<detail::struct_packable<T, detail::registered_fields_t<T>>::value>
+{
+};
+
+template<typename T>
+struct packable_traits<T, std::void_t<detail::registered_fields_t<T>>>
+  : detail::struct_packable<T, detail::registered_fields_t<T>>::traits
+{
+};
+
+} // namespace rdk
+
+#endif // !RDK_A831E49A9BC94659BA59F93F7A27B938
@@ -0,0 +1,62 @@
+#pragma once
+#ifndef RDK_B6CAF1365DB14E318685829E0CCF8463
+#define RDK_B6CAF1365DB14E318685829E0CCF8463
+
+#include "packer.hpp"
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace rdk
+{
+
+namespace detail
+{
+  /// field access for std::tuple and std::pair
+  template<typename Tuple>
+  struct tuple_fields
+  {
+    using value_type = Tuple;
+
+    template<size_t I>
+    static constexpr auto const &get(Tuple const &v) noexcept
+    {
+      return std::get<I>(v);
+    }
+
+    template<typename... Ts>
+    static constexpr Tuple make(Ts &&... fields)
+    {
+      return Tuple{std::forward<Ts>(fields)...};
+    }
+  };
+} // namespace detail
+
+/// tuples and pairs of packables are packed as their fields back to back, the first field in the lowest bits
+template<typename... Ps>
+struct is_packable<std::tuple<Ps...>> : std::bool_constant<(is_packable_v<Ps> && ...)>
+{
+};
+
+template<typename... Ps>
+struct packable_traits<std::tuple<Ps...>>
+  : detail::composite_packable_traits<detail::tuple_fields<std::tuple<Ps...>>, Ps...>
+{
+};
+
+template<typename P0, typename P1>
+struct is_packable<std::pair<P0, P1>> : std::bool_constant<(is_packable_v<P0> && is_packable_v<P1>)>
+{
+};
+
+template<typename P0, typename P1>
+struct packable_traits<std::pair<P0, P1>>
+  : detail::composite_packable_traits<detail::tuple_fields<std::pair<P0, P1>>, P0, P1>
+{
+};
+
+} // namespace rdk
+
+#endif // !RDK_B6CAF1365DB14E318685829E0CCF8463
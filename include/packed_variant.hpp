@@ -0,0 +1,291 @@
+#pragma once
+#ifndef RDK_DF2801031565424A90F643D25125A70C
+#define RDK_DF2801031565424A90F643D25125A70C
+
+#include "packer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace rdk
+{
+
+/// opts a std::variant into disjoint sum packing
+/// instead of a tag followed by the widest alternative, alternative i takes its own range of codes
+/// [base_i, base_i + max_code_i + 1) of a single code space, e.g. a variant of safe_unsigned<0, 99> and
+/// safe_unsigned<0, 9> takes 7 bits (110 codes) rather than 1 + 7 = 8
+/// all alternatives together must not take more than 2^64 codes
+template<typename Variant>
+class disjoint_sum : public Variant
+{
+public:
+  using variant_type = Variant;
+  using Variant::Variant;
+
+  constexpr disjoint_sum(Variant const &v)
+    : Variant(v)
+  {
+  }
+
+  constexpr Variant const &variant() const noexcept
+  {
+    return *this;
+  }
+};
+
+namespace detail
+{
+  template<typename Variant, typename... Ps>
+  struct variant_packable_traits
+  {
+    static_assert((is_packable_v<Ps> && ...), "variant: all alternatives must be packable");
+    static_assert(0U != sizeof...(Ps), "variant: there must be at least one alternative");
+
+  protected:
+    static constexpr size_t count = sizeof...(Ps);
+    using indices = std::index_sequence_for<Ps...>;
+
+    template<size_t I>
+    using alternative_traits = packable_traits<std::variant_alternative_t<I, std::variant<Ps...>>>;
+
+    static constexpr bool nothrow_pack = (noexcept(packable_traits<Ps>::pack(std::declval<Ps const &>())) && ...);
+    static constexpr bool nothrow_unpack = (noexcept(packable_traits<Ps>::unpack(std::declval<typename packable_traits<Ps>::packed_type const &>())) && ...);
+
+    template<size_t I, typename Alternative>
+    static constexpr Variant make(Alternative &&v)
+    {
+      return Variant{std::in_place_index<I>, std::forward<Alternative>(v)};
+    }
+  };
+
+  /// a tag of ceil(log2(count)) bits in the lowest bits, followed by the alternative
+  template<typename Variant, typename... Ps>
+  struct tagged_variant_traits : variant_packable_traits<Variant, Ps...>
+  {
+  private:
+    using base = variant_packable_traits<Variant, Ps...>;
+    using typename base::indices;
+    template<size_t I>
+    using alternative_traits = typename base::template alternative_traits<I>;
+
+    static constexpr size_t alternative_size = std::max({static_cast<size_t>(packable_traits<Ps>::packed_size)...});
+
+  public:
+    static constexpr size_t tag_size = (base::count > 1U) ? (1U + log2_v<(base::count - 1U)>) : 0U;
+    static constexpr uintmax_t packed_size = tag_size + alternative_size;
+    using value_type = Variant;
+    using packed_type = bitstream<packed_size>;
+
+  private:
+    static constexpr size_t tag_count = size_t{1U} << tag_size;
+    /// unless every tag names an alternative, unpacking may fail on corrupt data
+    static constexpr bool nothrow_unpack = base::nothrow_unpack && (tag_count == base::count);
+
+    template<size_t I>
+    static constexpr packed_type pack_alternative(value_type const &v) noexcept(base::nothrow_pack)
+    {
+      packed_type res;
+      res.insert(0U, tag_size, I);
+      res.insert(tag_size, alternative_traits<I>::pack(std::get<I>(v)));
+      return res;
+    }
+
+    template<size_t I>
+    static constexpr value_type unpack_alternative(packed_type const &v) noexcept(base::nothrow_unpack)
+    {
+      return base::template make<I>(alternative_traits<I>::unpack(v.template extract<alternative_traits<I>::packed_size>(tag_size)));
+    }
+
+    template<size_t... Is>
+    static constexpr auto make_packers(std::index_sequence<Is...>) noexcept
+    {
+      return std::array<packed_type (*)(value_type const &), base::count>{&pack_alternative<Is>...};
+    }
+
+    /// tags which don't name an alternative, which only come from corrupt data
+    [[noreturn]] static value_type unpack_invalid(packed_type const &)
+    {
+      raise<std::domain_error>("tagged variant: tag doesn't name an alternative.");
+    }
+
+    template<size_t... Is>
+    static constexpr auto make_unpackers(std::index_sequence<Is...>) noexcept
+    {
+      // every tag gets a slot, so no tag read from the data can index past the table
+      std::array<value_type (*)(packed_type const &), tag_count> res{};
+      for(auto &unpacker : res)
+      {
+        unpacker = &unpack_invalid;
+      }
+      ((res[Is] = &unpack_alternative<Is>), ...);
+      return res;
+    }
+
+    /// jump tables indexed by alternative, built once in read only data
+    static constexpr auto packers = make_packers(indices{});
+    static constexpr auto unpackers = make_unpackers(indices{});
+
+  public:
+    static constexpr packed_type pack(value_type const &v) noexcept(base::nothrow_pack)
+    {
+      assert(!v.valueless_by_exception());
+      return packers[v.index()](v);
+    }
+
+    /// throws std::domain_error for tags that don't name an alternative
+    static constexpr value_type unpack(packed_type const &v) noexcept(nothrow_unpack)
+    {
+      return unpackers[v.extract(0U, tag_size)](v);
+    }
+
+    static void pack_into(std::byte *base_ptr, size_t bit_offset, value_type const &v) noexcept(base::nothrow_pack)
+    {
+      store_bitstream(base_ptr, bit_offset, pack(v));
+    }
+
+    static value_type unpack_from(std::byte const *base_ptr, size_t bit_offset) noexcept(nothrow_unpack)
+    {
+      return unpack(load_bitstream<packed_size>(base_ptr, bit_offset));
+    }
+  };
+
+  template<typename Variant, typename... Ps>
+  struct disjoint_variant_traits : variant_packable_traits<Variant, Ps...>
+  {
+  private:
+    using base = variant_packable_traits<Variant, Ps...>;
+    using typename base::indices;
+    template<size_t I>
+    using alternative_traits = typename base::template alternative_traits<I>;
+
+    struct code_space
+    {
+      /// first code of each alternative
+      uint64_t bases[sizeof...(Ps)]{};
+      /// last code of the last alternative
+      uint64_t last{};
+      bool fits{true};
+    };
+
+    static constexpr code_space make_code_space() noexcept
+    {
+      constexpr uint64_t max_codes[] = {max_code_v<Ps>...};
+      code_space res{};
+      res.last = max_codes[0];
+      for(size_t i = 1U; i < base::count; ++i)
+      {
+        // alternative i takes max_codes[i] + 1 codes following the last one
+        res.fits = res.fits && (res.last < (~uint64_t{} - max_codes[i]));
+        res.bases[i] = res.last + 1U;
+        res.last = res.bases[i] + max_codes[i];
+      }
+      return res;
+    }
+
+    static constexpr code_space codes = make_code_space();
+    static_assert(codes.fits, "disjoint_sum: alternatives must not take more than 2^64 codes");
+
+  public:
+    static constexpr uintmax_t packed_size = bit_width(codes.last);
+    using value_type = disjoint_sum<Variant>;
+    using packed_type = bitstream<packed_size>;
+
+    /// first code of alternative I
+    template<size_t I>
+    static constexpr uint64_t code_base = codes.bases[I];
+
+  private:
+    template<size_t I>
+    static constexpr uint64_t pack_alternative(value_type const &v) noexcept(base::nothrow_pack)
+    {
+      return codes.bases[I] + alternative_traits<I>::pack(std::get<I>(v)).extract(0U, alternative_traits<I>::packed_size);
+    }
+
+    template<size_t I>
+    static constexpr value_type unpack_alternative(uint64_t code) noexcept(base::nothrow_unpack)
+    {
+      using packed_alternative = typename alternative_traits<I>::packed_type;
+      return value_type{base::template make<I>(alternative_traits<I>::unpack(packed_alternative{code - codes.bases[I]}))};
+    }
+
+    template<size_t... Is>
+    static constexpr auto make_packers(std::index_sequence<Is...>) noexcept
+    {
+      return std::array<uint64_t (*)(value_type const &), base::count>{&pack_alternative<Is>...};
+    }
+
+    template<size_t... Is>
+    static constexpr auto make_unpackers(std::index_sequence<Is...>) noexcept
+    {
+      return std::array<value_type (*)(uint64_t), base::count>{&unpack_alternative<Is>...};
+    }
+
+    /// jump tables indexed by alternative, built once in read only data
+    static constexpr auto packers = make_packers(indices{});
+    static constexpr auto unpackers = make_unpackers(indices{});
+
+    /// index of the alternative a code belongs to, counted without branches
+    template<size_t... Is>
+    static constexpr size_t alternative_of(uint64_t code, std::index_sequence<Is...>) noexcept
+    {
+      return (size_t{} + ... + static_cast<size_t>((0U != Is) && (code >= codes.bases[Is])));
+    }
+
+  public:
+    static constexpr packed_type pack(value_type const &v) noexcept(base::nothrow_pack)
+    {
+      assert(!v.valueless_by_exception());
+      return packed_type{packers[v.index()](v)};
+    }
+
+    static constexpr value_type unpack(packed_type const &v) noexcept(base::nothrow_unpack)
+    {
+      uint64_t const code = v.extract(0U, packed_size);
+      return unpackers[alternative_of(code, indices{})](code);
+    }
+
+    static void pack_into(std::byte *base_ptr, size_t bit_offset, value_type const &v) noexcept(base::nothrow_pack)
+    {
+      store_bits<packed_size>(base_ptr, bit_offset, pack(v).extract(0U, packed_size));
+    }
+
+    static value_type unpack_from(std::byte const *base_ptr, size_t bit_offset) noexcept(base::nothrow_unpack)
+    {
+      return unpack(packed_type{load_bits<packed_size>(base_ptr, bit_offset)});
+    }
+  };
+} // namespace detail
+
+template<typename... Ps>
+struct is_packable<std::variant<Ps...>> : std::bool_constant<(is_packable_v<Ps> && ...)>
+{
+};
+
+/// variants are packed as a tag of ceil(log2(sizeof...(Ps))) bits followed by the alternative, padded to the widest one
+template<typename... Ps>
+struct packable_traits<std::variant<Ps...>>
+  : detail::tagged_variant_traits<std::variant<Ps...>, Ps...>
+{
+};
+
+template<typename... Ps>
+struct is_packable<disjoint_sum<std::variant<Ps...>>> : std::bool_constant<(is_packable_v<Ps> && ...)>
+{
+};
+
+template<typename... Ps>
+struct packable_traits<disjoint_sum<std::variant<Ps...>>>
+  : detail::disjoint_variant_traits<std::variant<Ps...>, Ps...>
+{
+};
+
+} // namespace rdk
+
+#endif // !RDK_DF2801031565424A90F643D25125A70C
@@ -0,0 +1,603 @@
+#pragma once
+#ifndef RDK_AEB59789D1DC427DA4DAEB2D2B9A262A
+#define RDK_AEB59789D1DC427DA4DAEB2D2B9A262A
+
+#include "packer.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace rdk
+{
+
+namespace detail
+{
+  /// reads the packed representation of element index from a word array of elements stored back to back
+  template<typename T>
+  constexpr T read_element(uint64_t const *words, size_t index) noexcept
+  {
+    using traits = packable_traits<T>;
+    typename traits::packed_type packed;
+    extract_words<traits::packed_size>(words, index * traits::packed_size, packed.data());
+    return traits::unpack(packed);
+  }
+
+  /// overwrites element index in a word array of elements stored back to back with an already packed value
+  template<typename T>
+  constexpr void write_packed(uint64_t *words, size_t index, typename packable_traits<T>::packed_type const &packed) noexcept
+  {
+    insert_words<packable_traits<T>::packed_size>(words, index * packable_traits<T>::packed_size, packed.data());
+  }
+
+  /// overwrites element index in a word array of elements stored back to back
+  /// throws whatever packing throws, e.g. for checked enums outside of their range
+  template<typename T>
+  constexpr void write_element(uint64_t *words, size_t index, T const &v) noexcept(noexcept(packable_traits<T>::pack(v)))
+  {
+    write_packed<T>(words, index, packable_traits<T>::pack(v));
+  }
+} // namespace detail
+
+/// read only view of a range of packed elements stored back to back in 64 bit words
+/// element i of the view is element (first + i) of the word array, i.e. it starts at bit (first + i) * packed_size
+template<typename T>
+class packed_span
+{
+  static_assert(is_packable_v<T>, "packed_span: element type must be packable");
+
+public:
+  static constexpr size_t element_bits = packable_traits<T>::packed_size;
+
+  using value_type = T;
+  using size_type = size_t;
+
+  constexpr packed_span() noexcept = default;
+
+  constexpr packed_span(uint64_t const *words, size_t size, size_t first = 0U) noexcept
+    : words(words)
+    , first(first)
+    , count(size)
+  {
+  }
+
+  constexpr size_t size() const noexcept
+  {
+    return count;
+  }
+
+  constexpr bool empty() const noexcept
+  {
+    return (0U == count);
+  }
+
+  constexpr T operator[](size_t i) const noexcept
+  {
+    assert(i < count);
+    return detail::read_element<T>(words, first + i);
+  }
+
+  constexpr packed_span subspan(size_t offset, size_t n) const noexcept
+  {
+    assert((offset + n) <= count);
+    return packed_span{words, n, first + offset};
+  }
+
+  constexpr uint64_t const *data() const noexcept
+  {
+    return words;
+  }
+
+  /// index of the view's first element in the word array
+  constexpr size_t offset() const noexcept
+  {
+    return first;
+  }
+
+  /// number of words spanned from data() up to the view's last element
+  constexpr size_t word_count() const noexcept
+  {
+    return (((first + count) * element_bits) + (detail::word_bits - 1U)) / detail::word_bits;
+  }
+
+private:
+  uint64_t const *words{};
+  size_t first{};
+  size_t count{};
+};
+
+/// random access container of packable values
+/// elements are stored back to back in 64 bit words using exactly packable_traits<T>::packed_size bits each
+/// like std::vector<bool>, element access goes through a proxy reference
+template<typename T>
+class packed_vector
+{
+  static_assert(is_packable_v<T>, "packed_vector: element type must be packable");
+
+public:
+  static constexpr size_t element_bits = packable_traits<T>::packed_size;
+
+  using value_type = T;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+  using const_reference = T;
+
+  /// proxy referring to a single element
+  class reference
+  {
+  public:
+    constexpr reference(reference const &) noexcept = default;
+
+    constexpr operator T() const noexcept
+    {
+      return detail::read_element<T>(words, index);
+    }
+
+    constexpr reference &operator=(T const &v) noexcept(noexcept(packable_traits<T>::pack(v)))
+    {
+      detail::write_element(words, index, v);
+      return *this;
+    }
+
+    constexpr reference &operator=(reference const &other) noexcept
+    {
+      return (*this = static_cast<T>(other));
+    }
+
+    friend constexpr bool operator==(reference const &lhs, reference const &rhs)
+    {
+      return (static_cast<T>(lhs) == static_cast<T>(rhs));
+    }
+
+    friend constexpr bool operator!=(reference const &lhs, reference const &rhs)
+    {
+      return !(lhs == rhs);
+    }
+
+    friend constexpr bool operator==(reference const &lhs, T const &rhs)
+    {
+      return (static_cast<T>(lhs) == rhs);
+    }
+
+    friend constexpr bool operator==(T const &lhs, reference const &rhs)
+    {
+      return (lhs == static_cast<T>(rhs));
+    }
+
+    friend constexpr bool operator!=(reference const &lhs, T const &rhs)
+    {
+      return !(lhs == rhs);
+    }
+
+    friend constexpr bool operator!=(T const &lhs, reference const &rhs)
+    {
+      return !(lhs == rhs);
+    }
+
+    friend void swap(reference lhs, reference rhs) noexcept
+    {
+      T const tmp = lhs;
+      lhs = static_cast<T>(rhs);
+      rhs = tmp;
+    }
+
+  private:
+    friend class packed_vector;
+
+    constexpr reference(uint64_t *words, size_t index) noexcept
+      : words(words)
+      , index(index)
+    {
+    }
+
+    uint64_t *words;
+    size_t index;
+  };
+
+private:
+  template<bool is_const>
+  class basic_iterator
+  {
+    using word_pointer = std::conditional_t<is_const, uint64_t const *, uint64_t *>;
+
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = T;
+    using difference_type = ptrdiff_t;
+    using reference = std::conditional_t<is_const, T, typename packed_vector::reference>;
+    using pointer = void;
+
+    constexpr basic_iterator() noexcept = default;
+
+    /// iterators convert to const_iterators
+    template<bool other_const, typename = std::enable_if_t<(is_const && !other_const)>>
+    constexpr basic_iterator(basic_iterator<other_const> const &other) noexcept
+      : words(other.words)
+      , index(other.index)
+    {
+    }
+
+    constexpr reference operator*() const noexcept
+    {
+      if constexpr(is_const)
+      {
+        return detail::read_element<T>(words, index);
+      }
+      else
+      {
+        return reference{words, index};
+      }
+    }
+
+    constexpr reference operator[](difference_type n) const noexcept
+    {
+      return *(*this + n);
+    }
+
+    constexpr basic_iterator &operator++() noexcept
+    {
+      ++index;
+      return *this;
+    }
+
+    constexpr basic_iterator operator++(int) noexcept
+    {
+      auto res = *this;
+      ++index;
+      return res;
+    }
+
+    constexpr basic_iterator &operator--() noexcept
+    {
+      --index;
+      return *this;
+    }
+
+    constexpr basic_iterator operator--(int) noexcept
+    {
+      auto res = *this;
+      --index;
+      return res;
+    }
+
+    constexpr basic_iterator &operator+=(difference_type n) noexcept
+    {
+      index = static_cast<size_t>(static_cast<difference_type>(index) + n);
+      return *this;
+    }
+
+    constexpr basic_iterator &operator-=(difference_type n) noexcept
+    {
+      return (*this += -n);
+    }
+
+    friend constexpr basic_iterator operator+(basic_iterator it, difference_type n) noexcept
+    {
+      return (it += n);
+    }
+
+    friend constexpr basic_iterator operator+(difference_type n, basic_iterator it) noexcept
+    {
+      return (it += n);
+    }
+
+    friend constexpr basic_iterator operator-(basic_iterator it, difference_type n) noexcept
+    {
+      return (it -= n);
+    }
+
+    friend constexpr difference_type operator-(basic_iterator const &lhs, basic_iterator const &rhs) noexcept
+    {
+      return static_cast<difference_type>(lhs.index) - static_cast<difference_type>(rhs.index);
+    }
+
+    friend constexpr bool operator==(basic_iterator const &lhs, basic_iterator const &rhs) noexcept
+    {
+      return (lhs.index == rhs.index);
+    }
+
+    friend constexpr bool operator!=(basic_iterator const &lhs, basic_iterator const &rhs) noexcept
+    {
+      return !(lhs == rhs);
+    }
+
+    friend constexpr bool operator<(basic_iterator const &lhs, basic_iterator const &rhs) noexcept
+    {
+      return (lhs.index < rhs.index);
+    }
+
+    friend constexpr bool operator>(basic_iterator const &lhs, basic_iterator const &rhs) noexcept
+    {
+      return (rhs < lhs);
+    }
+
+    friend constexpr bool operator<=(basic_iterator const &lhs, basic_iterator const &rhs) noexcept
+    {
+      return !(rhs < lhs);
+    }
+
+    friend constexpr bool operator>=(basic_iterator const &lhs, basic_iterator const &rhs) noexcept
+    {
+      return !(lhs < rhs);
+    }
+
+  private:
+    friend class packed_vector;
+
+    template<bool>
+    friend class basic_iterator;
+
+    constexpr basic_iterator(word_pointer words, size_t index) noexcept
+      : words(words)
+      , index(index)
+    {
+    }
+
+    word_pointer words{};
+    size_t index{};
+  };
+
+public:
+  using iterator = basic_iterator<false>;
+  using const_iterator = basic_iterator<true>;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  packed_vector() = default;
+
+  packed_vector(size_t n, T const &v)
+  {
+    resize(n, v);
+  }
+
+  packed_vector(std::initializer_list<T> values)
+  {
+    reserve(values.size());
+    for(auto const &v : values)
+    {
+      push_back(v);
+    }
+  }
+
+  template<typename It, typename = typename std::iterator_traits<It>::iterator_category>
+  packed_vector(It first, It last)
+  {
+    for(; first != last; ++first)
+    {
+      push_back(*first);
+    }
+  }
+
+  size_t size() const noexcept
+  {
+    return count;
+  }
+
+  bool empty() const noexcept
+  {
+    return (0U == count);
+  }
+
+  static constexpr size_t max_size() noexcept
+  {
+    return (0U == element_bits) ? std::numeric_limits<size_t>::max() : (std::numeric_limits<size_t>::max() / element_bits);
+  }
+
+  /// number of elements that fit into the allocated words
+  size_t capacity() const noexcept
+  {
+    return (0U == element_bits) ? max_size() : ((words.capacity() * detail::word_bits) / element_bits);
+  }
+
+  void reserve(size_t n)
+  {
+    words.reserve(words_for(n));
+  }
+
+  void shrink_to_fit()
+  {
+    words.shrink_to_fit();
+  }
+
+  void clear() noexcept
+  {
+    words.clear();
+    count = 0U;
+  }
+
+  void push_back(T const &v)
+  {
+    // pack first, so a value that can't be packed leaves the vector unchanged
+    auto const packed = packable_traits<T>::pack(v);
+    // elements wider than a word may need more than one new word
+    size_t const needed = words_for(count + 1U);
+    if(needed > words.size())
+    {
+      words.resize(needed);
+    }
+    detail::write_packed<T>(words.data(), count, packed);
+    ++count;
+  }
+
+  void pop_back() noexcept
+  {
+    assert(!empty());
+    truncate(count - 1U);
+  }
+
+  void resize(size_t n, T const &v)
+  {
+    if(n <= count)
+    {
+      truncate(n);
+      return;
+    }
+
+    auto const packed = packable_traits<T>::pack(v);
+    words.resize(words_for(n));
+    for(; count < n; ++count)
+    {
+      detail::write_packed<T>(words.data(), count, packed);
+    }
+  }
+
+  reference operator[](size_t i) noexcept
+  {
+    assert(i < count);
+    return reference{words.data(), i};
+  }
+
+  const_reference operator[](size_t i) const noexcept
+  {
+    assert(i < count);
+    return detail::read_element<T>(words.data(), i);
+  }
+
+  reference at(size_t i)
+  {
+    check_index(i);
+    return (*this)[i];
+  }
+
+  const_reference at(size_t i) const
+  {
+    check_index(i);
+    return (*this)[i];
+  }
+
+  reference front() noexcept
+  {
+    return (*this)[0U];
+  }
+
+  const_reference front() const noexcept
+  {
+    return (*this)[0U];
+  }
+
+  reference back() noexcept
+  {
+    return (*this)[count - 1U];
+  }
+
+  const_reference back() const noexcept
+  {
+    return (*this)[count - 1U];
+  }
+
+  iterator begin() noexcept
+  {
+    return iterator{words.data(), 0U};
+  }
+
+  iterator end() noexcept
+  {
+    return iterator{words.data(), count};
+  }
+
+  const_iterator begin() const noexcept
+  {
+    return const_iterator{words.data(), 0U};
+  }
+
+  const_iterator end() const noexcept
+  {
+    return const_iterator{words.data(), count};
+  }
+
+  const_iterator cbegin() const noexcept
+  {
+    return begin();
+  }
+
+  const_iterator cend() const noexcept
+  {
+    return end();
+  }
+
+  reverse_iterator rbegin() noexcept
+  {
+    return reverse_iterator{end()};
+  }
+
+  reverse_iterator rend() noexcept
+  {
+    return reverse_iterator{begin()};
+  }
+
+  const_reverse_iterator rbegin() const noexcept
+  {
+    return const_reverse_iterator{end()};
+  }
+
+  const_reverse_iterator rend() const noexcept
+  {
+    return const_reverse_iterator{begin()};
+  }
+
+  /// underlying words; element i occupies bits [i * element_bits, (i + 1) * element_bits), bits past the last element are zero
+  uint64_t const *data() const noexcept
+  {
+    return words.data();
+  }
+
+  /// number of words holding elements
+  size_t word_count() const noexcept
+  {
+    return words.size();
+  }
+
+  packed_span<T> span() const noexcept
+  {
+    return packed_span<T>{words.data(), count};
+  }
+
+  friend bool operator==(packed_vector const &lhs, packed_vector const &rhs) noexcept
+  {
+    return (lhs.count == rhs.count) && (lhs.words == rhs.words);
+  }
+
+  friend bool operator!=(packed_vector const &lhs, packed_vector const &rhs) noexcept
+  {
+    return !(lhs == rhs);
+  }
+
+private:
+  static constexpr size_t words_for(size_t n) noexcept
+  {
+    return ((n * element_bits) + (detail::word_bits - 1U)) / detail::word_bits;
+  }
+
+  void check_index(size_t i) const
+  {
+    if(i >= count)
+    {
+      detail::raise<std::out_of_range>("packed_vector: index out of range");
+    }
+  }
+
+  /// drops the elements from n onwards and clears their bits, so equal contents compare equal word by word
+  void truncate(size_t n) noexcept
+  {
+    count = n;
+    words.resize(words_for(n));
+    size_t const used = (n * element_bits) % detail::word_bits;
+    if(0U != used)
+    {
+      words.back() &= detail::low_mask(used);
+    }
+  }
+
+  std::vector<uint64_t> words;
+  size_t count{};
+};
+
+} // namespace rdk
+
+#endif // !RDK_AEB59789D1DC427DA4DAEB2D2B9A262A
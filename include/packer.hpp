@@ -2,9 +2,33 @@
 #ifndef RDK_03F2F1279F55C951054ADBCFDAE92797
 #define RDK_03F2F1279F55C951054ADBCFDAE92797
 
+#include <cassert>
+#include <cstddef>
 #include <cstdint>
-#include <bitset>
+#include <cstring>
+#include <exception>
+#include <tuple>
 #include <type_traits>
+#include <utility>
+
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+#define RDK_BIG_ENDIAN 1
+#endif
+
+#if defined(__SIZEOF_INT128__)
+#define RDK_HAS_INT128 1
+#endif
+
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+#define RDK_HAS_EXCEPTIONS 1
+#endif
+
+/// keeps error paths out of line, so they don't get in the way of inlining and vectorizing the hot path
+#if defined(_MSC_VER) && !defined(__clang__)
+#define RDK_COLD __declspec(noinline)
+#else
+#define RDK_COLD __attribute__((cold, noinline))
+#endif
 
 namespace rdk
 {
@@ -27,7 +51,8 @@ struct log2<1U> : std::integral_constant<uintmax_t, 0U>
 template<uintmax_t v>
 constexpr uintmax_t log2_v = log2<v>::value;
 
-template<typename T>
+/// the second parameter allows constraining partial specializations with std::void_t
+template<typename T, typename = void>
 struct is_packable : std::false_type
 {
 };
@@ -35,15 +60,613 @@ struct is_packable : std::false_type
 template<typename T>
 constexpr bool is_packable_v = is_packable<T>::value;
 
-// @@@TODO: more suitable type
+namespace detail
+{
+  /// throws E, or terminates when compiled without exceptions
+  template<typename E>
+  [[noreturn]] RDK_COLD void raise(char const *what)
+  {
+#ifdef RDK_HAS_EXCEPTIONS
+    throw E(what);
+#else
+    (void)what;
+    std::terminate();
+#endif
+  }
+} // namespace detail
+
+// word level bit manipulation helpers
+namespace detail
+{
+  constexpr size_t word_bits = 64U;
+
+  /// mask with the lowest width bits set (width in [0, 64])
+  constexpr uint64_t low_mask(size_t width) noexcept
+  {
+    return ((uint64_t{1U} << (width & (word_bits - 1U))) - 1U) | (uint64_t{} - static_cast<uint64_t>(width / word_bits));
+  }
+
+  /// number of bits needed to represent v
+  constexpr size_t bit_width(uint64_t v) noexcept
+  {
+    size_t res{};
+    for(; 0U != v; v >>= 1U)
+    {
+      ++res;
+    }
+    return res;
+  }
+
+#ifdef RDK_HAS_INT128
+  __extension__ typedef __int128 int128_t;
+  __extension__ typedef unsigned __int128 uint128_t;
+#endif
+
+  /// high word of the 128 bit product a * b
+  constexpr uint64_t mulhi64(uint64_t a, uint64_t b) noexcept
+  {
+#ifdef RDK_HAS_INT128
+    return static_cast<uint64_t>((static_cast<uint128_t>(a) * b) >> word_bits);
+#else
+    uint64_t const a_lo = a & 0xFFFFFFFFU;
+    uint64_t const a_hi = a >> 32U;
+    uint64_t const b_lo = b & 0xFFFFFFFFU;
+    uint64_t const b_hi = b >> 32U;
+    uint64_t const lo_lo = a_lo * b_lo;
+    uint64_t const hi_lo = a_hi * b_lo;
+    uint64_t const lo_hi = a_lo * b_hi;
+    uint64_t const cross = (lo_lo >> 32U) + (hi_lo & 0xFFFFFFFFU) + lo_hi;
+    return (a_hi * b_hi) + (hi_lo >> 32U) + (cross >> 32U);
+#endif
+  }
+
+  /// divides 64 bit values by a fixed divisor with a multiplication and two shifts instead of a division
+  /// (Granlund and Montgomery, "Division by invariant integers using multiplication")
+  /// constructing a divider is slow, it's meant to be built at compile time or once per divisor
+  class divider
+  {
+  public:
+    constexpr explicit divider(uint64_t d) noexcept
+    {
+      assert(0U != d);
+      // l = ceil(log2(d))
+      size_t l{};
+      while((l < word_bits) && ((uint64_t{1U} << l) < d))
+      {
+        ++l;
+      }
+
+      if(0U == (d & (d - 1U)))
+      {
+        // powers of two reduce to a shift, magic stays zero
+        shift1 = (0U == l) ? 0U : 1U;
+        shift2 = (0U == l) ? 0U : (l - 1U);
+        return;
+      }
+
+      // magic = floor(2^64 * (2^l - d) / d) + 1, by long division of the 128 bit numerator
+      // the numerator's high word 2^l - d is below d, so the quotient fits into a word
+      uint64_t rem = (l < word_bits) ? ((uint64_t{1U} << l) - d) : (uint64_t{} - d);
+      uint64_t quot{};
+      for(size_t i{}; i < word_bits; ++i)
+      {
+        bool const carry = (0U != (rem >> (word_bits - 1U)));
+        rem <<= 1U;
+        quot <<= 1U;
+        if(carry || (rem >= d))
+        {
+          rem -= d;
+          quot |= 1U;
+        }
+      }
+      magic = quot + 1U;
+      shift1 = 1U;
+      shift2 = l - 1U;
+    }
+
+    constexpr uint64_t divide(uint64_t n) const noexcept
+    {
+      uint64_t const t = mulhi64(n, magic);
+      return (t + ((n - t) >> shift1)) >> shift2;
+    }
+
+  private:
+    uint64_t magic{};
+    size_t shift1{};
+    size_t shift2{};
+  };
+
+  /// reads width (<= 64) bits starting at bit offset from a little endian word array
+  /// only touches the words actually spanned by the range
+  constexpr uint64_t extract_bits(uint64_t const *words, size_t offset, size_t width) noexcept
+  {
+    size_t const index = offset / word_bits;
+    size_t const shift = offset % word_bits;
+    size_t const next = index + static_cast<size_t>((shift + width) > word_bits);
+
+    // (x << 1) << (63 - shift) == x << (64 - shift), but stays defined for shift == 0
+    uint64_t const lo = words[index] >> shift;
+    uint64_t const hi = (words[next] << 1U) << ((word_bits - 1U) - shift);
+    return (lo | hi) & low_mask(width);
+  }
+
+  /// overwrites width (<= 64) bits starting at bit offset in a little endian word array
+  /// only touches the words actually spanned by the range
+  constexpr void insert_bits(uint64_t *words, size_t offset, size_t width, uint64_t value) noexcept
+  {
+    size_t const index = offset / word_bits;
+    size_t const shift = offset % word_bits;
+    size_t const next = index + static_cast<size_t>((shift + width) > word_bits);
+
+    uint64_t const mask = low_mask(width);
+    value &= mask;
+
+    words[index] = (words[index] & ~(mask << shift)) | (value << shift);
+    // if the range doesn't cross into the next word both high parts are zero and this is a no-op
+    words[next] = (words[next] & ~((mask >> 1U) >> ((word_bits - 1U) - shift))) | ((value >> 1U) >> ((word_bits - 1U) - shift));
+  }
+
+  /// copies width bits starting at bit offset of words into out, one whole word at a time
+  /// out must hold (width + 63) / 64 words; the bits past width in its last word are cleared
+  template<size_t width>
+  constexpr void extract_words(uint64_t const *words, size_t offset, uint64_t *out) noexcept
+  {
+    for(size_t i{}; i < (width / word_bits); ++i)
+    {
+      out[i] = extract_bits(words, offset + (i * word_bits), word_bits);
+    }
+    if(0U != (width % word_bits))
+    {
+      out[width / word_bits] = extract_bits(words, offset + (width - (width % word_bits)), width % word_bits);
+    }
+  }
+
+  /// overwrites width bits starting at bit offset of words with the bits of in, one whole word at a time
+  template<size_t width>
+  constexpr void insert_words(uint64_t *words, size_t offset, uint64_t const *in) noexcept
+  {
+    for(size_t i{}; i < (width / word_bits); ++i)
+    {
+      insert_bits(words, offset + (i * word_bits), word_bits, in[i]);
+    }
+    if(0U != (width % word_bits))
+    {
+      insert_bits(words, offset + (width - (width % word_bits)), width % word_bits, in[width / word_bits]);
+    }
+  }
+
+  /// loads a little endian word from a possibly unaligned address
+  inline uint64_t load_le64(std::byte const *p) noexcept
+  {
+    uint64_t res;
+    std::memcpy(&res, p, sizeof(res));
+#ifdef RDK_BIG_ENDIAN
+    res = __builtin_bswap64(res);
+#endif
+    return res;
+  }
+
+  /// stores a little endian word to a possibly unaligned address
+  inline void store_le64(std::byte *p, uint64_t v) noexcept
+  {
+#ifdef RDK_BIG_ENDIAN
+    v = __builtin_bswap64(v);
+#endif
+    std::memcpy(p, &v, sizeof(v));
+  }
+
+  /// loads the lowest count (<= 8) bytes of a little endian word, the remaining bytes read as zero
+  inline uint64_t load_le64_partial(std::byte const *p, size_t count) noexcept
+  {
+    uint64_t res{};
+    for(size_t i{}; i < count; ++i)
+    {
+      res |= static_cast<uint64_t>(std::to_integer<uint8_t>(p[i])) << (8U * i);
+    }
+    return res;
+  }
+
+  /// stores the lowest count (<= 8) bytes of a little endian word
+  inline void store_le64_partial(std::byte *p, uint64_t v, size_t count) noexcept
+  {
+    for(size_t i{}; i < count; ++i)
+    {
+      p[i] = static_cast<std::byte>(v >> (8U * i));
+    }
+  }
+
+  /// loads count (<= 8) bytes as the low bytes of a little endian word, the remaining bytes read as zero
+  template<size_t count>
+  uint64_t load_le_bytes(std::byte const *p) noexcept
+  {
+    std::byte tmp[sizeof(uint64_t)]{};
+    std::memcpy(tmp, p, count);
+    return load_le64(tmp);
+  }
+
+  /// stores the low count (<= 8) bytes of a little endian word
+  template<size_t count>
+  void store_le_bytes(std::byte *p, uint64_t v) noexcept
+  {
+    std::byte tmp[sizeof(uint64_t)];
+    store_le64(tmp, v);
+    std::memcpy(p, tmp, count);
+  }
+
+  /// reads width (<= 64) bits starting at bit offset of a byte buffer in bit_writer layout
+  /// only touches the bytes actually spanned by the range
+  template<size_t width>
+  uint64_t load_bits(std::byte const *base, size_t offset) noexcept
+  {
+    static_assert(width <= word_bits, "load_bits: at most one word can be loaded at a time");
+    if constexpr(0U == width)
+    {
+      return 0U;
+    }
+    else
+    {
+      // the first (width + 7) / 8 bytes are spanned regardless of the offset, only the one after may not be
+      constexpr size_t count = (width + 7U) / 8U;
+      std::byte const *p = base + (offset / 8U);
+      size_t const shift = offset % 8U;
+
+      uint64_t res = load_le_bytes<count>(p) >> shift;
+      if((shift + width) > (8U * count))
+      {
+        // (x << 1) << (8 * count - 1 - shift) == x << (8 * count - shift), but stays defined for count == 8
+        res |= (static_cast<uint64_t>(std::to_integer<uint8_t>(p[count])) << 1U) << (((8U * count) - 1U) - shift);
+      }
+      return res & low_mask(width);
+    }
+  }
+
+  /// overwrites width (<= 64) bits starting at bit offset of a byte buffer in bit_writer layout
+  /// only touches the bytes actually spanned by the range
+  template<size_t width>
+  void store_bits(std::byte *base, size_t offset, uint64_t value) noexcept
+  {
+    static_assert(width <= word_bits, "store_bits: at most one word can be stored at a time");
+    if constexpr(0U != width)
+    {
+      constexpr size_t count = (width + 7U) / 8U;
+      constexpr uint64_t mask = low_mask(width);
+      std::byte *p = base + (offset / 8U);
+      size_t const shift = offset % 8U;
+      value &= mask;
+
+      store_le_bytes<count>(p, (load_le_bytes<count>(p) & ~(mask << shift)) | (value << shift));
+      if((shift + width) > (8U * count))
+      {
+        size_t const spill = (8U * count) - shift;
+        auto const keep = static_cast<uint8_t>(~(mask >> spill));
+        p[count] = static_cast<std::byte>((std::to_integer<uint8_t>(p[count]) & keep) | static_cast<uint8_t>(value >> spill));
+      }
+    }
+  }
+} // namespace detail
+
+/// fixed size bit container used as the packed representation of packable types
+/// bit i is stored in bit (i % 64) of word (i / 64); bits past the size are always zero
 template<size_t bits>
-using bitstream = std::bitset<bits>;
+class bitstream
+{
+public:
+  static constexpr size_t word_count = (bits + detail::word_bits - 1U) / detail::word_bits;
 
-template<typename T>
+  constexpr bitstream() noexcept
+    : words{}
+  {
+  }
+
+  /// initializes the lowest min(bits, 64) bits from v
+  constexpr explicit bitstream(uint64_t v) noexcept
+    : words{}
+  {
+    insert(0U, (bits < detail::word_bits) ? bits : detail::word_bits, v);
+  }
+
+  static constexpr size_t size() noexcept
+  {
+    return bits;
+  }
+
+  constexpr uint64_t word(size_t i) const noexcept
+  {
+    assert(i < word_count);
+    return words[i];
+  }
+
+  constexpr uint64_t const *data() const noexcept
+  {
+    return words;
+  }
+
+  constexpr uint64_t *data() noexcept
+  {
+    return words;
+  }
+
+  /// reads width (<= 64) bits starting at offset
+  constexpr uint64_t extract(size_t offset, size_t width) const noexcept
+  {
+    assert((width <= detail::word_bits) && ((offset + width) <= bits));
+    return (0U == width) ? 0U : detail::extract_bits(words, offset, width);
+  }
+
+  /// overwrites width (<= 64) bits starting at offset with the low bits of value
+  constexpr void insert(size_t offset, size_t width, uint64_t value) noexcept
+  {
+    assert((width <= detail::word_bits) && ((offset + width) <= bits));
+    if(0U != width)
+    {
+      detail::insert_bits(words, offset, width, value);
+    }
+  }
+
+  /// reads an arbitrarily wide range of bits starting at offset
+  template<size_t width>
+  constexpr bitstream<width> extract(size_t offset) const noexcept
+  {
+    assert((offset + width) <= bits);
+    bitstream<width> res;
+    detail::extract_words<width>(words, offset, res.data());
+    return res;
+  }
+
+  /// overwrites an arbitrarily wide range of bits starting at offset
+  template<size_t width>
+  constexpr void insert(size_t offset, bitstream<width> const &value) noexcept
+  {
+    assert((offset + width) <= bits);
+    detail::insert_words<width>(words, offset, value.data());
+  }
+
+  friend constexpr bool operator==(bitstream const &lhs, bitstream const &rhs) noexcept
+  {
+    for(size_t i{}; i < word_count; ++i)
+    {
+      if(lhs.words[i] != rhs.words[i])
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  friend constexpr bool operator!=(bitstream const &lhs, bitstream const &rhs) noexcept
+  {
+    return !(lhs == rhs);
+  }
+
+private:
+  // keep one word around for empty streams so we never declare a zero sized array
+  uint64_t words[(0U != word_count) ? word_count : 1U];
+};
+
+template<typename T, typename = void>
 struct packable_traits;
 
+namespace detail
+{
+  /// bit layout of several packables stored back to back, the first one in the lowest bits
+  template<typename... Ps>
+  struct packed_layout
+  {
+    static constexpr size_t count = sizeof...(Ps);
+    static constexpr size_t sizes[count + 1U] = {static_cast<size_t>(packable_traits<Ps>::packed_size)..., 0U};
+
+    /// bit offset of the i-th field
+    static constexpr size_t offset(size_t i) noexcept
+    {
+      size_t res{};
+      for(size_t j{}; j < i; ++j)
+      {
+        res += sizes[j];
+      }
+      return res;
+    }
+
+    static constexpr size_t size = offset(count);
+  };
+
+  /// reads a bitstream starting at bit offset of a byte buffer in bit_writer layout
+  template<size_t bits>
+  bitstream<bits> load_bitstream(std::byte const *base, size_t offset) noexcept
+  {
+    bitstream<bits> res;
+    for(size_t i{}; i < (bits / word_bits); ++i)
+    {
+      res.insert(i * word_bits, word_bits, load_bits<word_bits>(base, offset + (i * word_bits)));
+    }
+    constexpr size_t tail = bits % word_bits;
+    if constexpr(0U != tail)
+    {
+      res.insert(bits - tail, tail, load_bits<tail>(base, offset + (bits - tail)));
+    }
+    return res;
+  }
+
+  /// overwrites the bits starting at bit offset of a byte buffer in bit_writer layout with a bitstream
+  template<size_t bits>
+  void store_bitstream(std::byte *base, size_t offset, bitstream<bits> const &v) noexcept
+  {
+    for(size_t i{}; i < (bits / word_bits); ++i)
+    {
+      store_bits<word_bits>(base, offset + (i * word_bits), v.word(i));
+    }
+    constexpr size_t tail = bits % word_bits;
+    if constexpr(0U != tail)
+    {
+      store_bits<tail>(base, offset + (bits - tail), v.word(bits / word_bits));
+    }
+  }
+
+  /// whether packable T has a code pack never produces, traits then provide has_niche, niche() and is_niche(packed)
+  /// e.g. std::optional stores nullopt there instead of spending an extra bit
+  template<typename T, typename = void>
+  struct has_niche : std::false_type
+  {
+  };
+
+  template<typename T>
+  struct has_niche<T, std::enable_if_t<packable_traits<T>::has_niche>> : std::true_type
+  {
+  };
+
+  template<typename T>
+  constexpr bool has_niche_v = has_niche<T>::value;
+
+  /// largest code pack produces for packable T, traits may declare it as max_code if it's below the all ones code
+  template<typename T, typename = void>
+  struct max_code : std::integral_constant<uint64_t, low_mask(packable_traits<T>::packed_size)>
+  {
+  };
+
+  template<typename T>
+  struct max_code<T, std::void_t<decltype(packable_traits<T>::max_code)>> : std::integral_constant<uint64_t, packable_traits<T>::max_code>
+  {
+  };
+
+  template<typename T>
+  constexpr uint64_t max_code_v = max_code<T>::value;
+
+  /// index of the first of Ps that has a niche, sizeof...(Ps) if none has
+  template<typename... Ps>
+  constexpr size_t first_niche() noexcept
+  {
+    constexpr bool niches[sizeof...(Ps) + 1U] = {has_niche_v<Ps>..., true};
+    size_t i{};
+    while(!niches[i])
+    {
+      ++i;
+    }
+    return i;
+  }
+
+  /// traits of a record of several packables stored back to back as described by packed_layout
+  /// Fields provides value_type, get<I>(record) returning field I and make(fields...) building a record
+  /// all offsets are compile time constants, so packing a record unrolls into one shift / mask per field
+  template<typename Fields, typename... Ps>
+  struct composite_packable_traits
+  {
+    static_assert((is_packable_v<Ps> && ...), "composite: all fields must be packable");
+
+  private:
+    using layout = packed_layout<Ps...>;
+    using indices = std::index_sequence_for<Ps...>;
+
+  public:
+    static constexpr uintmax_t packed_size = layout::size;
+    using value_type = typename Fields::value_type;
+    using packed_type = bitstream<packed_size>;
+
+    /// bit offset of field I
+    template<size_t I>
+    static constexpr size_t offset = layout::offset(I);
+
+    using fields = Fields;
+    using field_types = std::tuple<Ps...>;
+
+  private:
+    static constexpr bool nothrow_pack = (noexcept(packable_traits<Ps>::pack(std::declval<Ps const &>())) && ...);
+    static constexpr bool nothrow_unpack = (noexcept(packable_traits<Ps>::unpack(std::declval<typename packable_traits<Ps>::packed_type const &>())) && ...);
+
+    template<size_t... Is>
+    static constexpr packed_type pack_impl(value_type const &v, std::index_sequence<Is...>) noexcept(nothrow_pack)
+    {
+      packed_type res;
+      (res.insert(offset<Is>, packable_traits<Ps>::pack(Fields::template get<Is>(v))), ...);
+      return res;
+    }
+
+    template<size_t... Is>
+    static constexpr value_type unpack_impl(packed_type const &v, std::index_sequence<Is...>) noexcept(nothrow_unpack)
+    {
+      return Fields::make(packable_traits<Ps>::unpack(v.template extract<packable_traits<Ps>::packed_size>(offset<Is>))...);
+    }
+
+  public:
+    static constexpr packed_type pack(value_type const &v) noexcept(nothrow_pack)
+    {
+      return pack_impl(v, indices{});
+    }
+
+    static constexpr value_type unpack(packed_type const &v) noexcept(nothrow_unpack)
+    {
+      return unpack_impl(v, indices{});
+    }
+
+    static void pack_into(std::byte *base, size_t bit_offset, value_type const &v) noexcept(nothrow_pack)
+    {
+      store_bitstream(base, bit_offset, pack(v));
+    }
+
+    static value_type unpack_from(std::byte const *base, size_t bit_offset) noexcept(nothrow_unpack)
+    {
+      return unpack(load_bitstream<packed_size>(base, bit_offset));
+    }
+
+  private:
+    static constexpr size_t niche_field = first_niche<Ps...>();
+    template<size_t I>
+    using field_traits = packable_traits<std::tuple_element_t<I, std::tuple<Ps...>>>;
+
+  public:
+    /// records borrow the niche of their first field that has one
+    static constexpr bool has_niche = (niche_field < sizeof...(Ps));
+
+    static constexpr packed_type niche() noexcept
+    {
+      static_assert(has_niche, "composite: no field has a niche");
+      packed_type res;
+      res.insert(offset<niche_field>, field_traits<niche_field>::niche());
+      return res;
+    }
+
+    static constexpr bool is_niche(packed_type const &v) noexcept
+    {
+      static_assert(has_niche, "composite: no field has a niche");
+      return field_traits<niche_field>::is_niche(v.template extract<field_traits<niche_field>::packed_size>(offset<niche_field>));
+    }
+  };
+} // namespace detail
+
+/// writes the packed representation of v into a caller owned buffer, starting at the given bit offset
+/// the layout is the one produced by bit_writer, so values can be patched in place in an encoded stream
+/// only the bytes spanned by the packed value are touched
+template<typename T>
+void pack_into(std::byte *base, size_t bit_offset, T const &v) noexcept(noexcept(packable_traits<T>::pack_into(base, bit_offset, v)))
+{
+  static_assert(is_packable_v<T>, "pack_into: type must be packable");
+  packable_traits<T>::pack_into(base, bit_offset, v);
+}
+
+/// reads a packed value from a caller owned buffer, starting at the given bit offset
+template<typename T>
+T unpack_from(std::byte const *base, size_t bit_offset) noexcept(noexcept(packable_traits<T>::unpack_from(base, bit_offset)))
+{
+  static_assert(is_packable_v<T>, "unpack_from: type must be packable");
+  return packable_traits<T>::unpack_from(base, bit_offset);
+}
+
+namespace detail
+{
+  template<typename T>
+  struct is_bitstream : std::false_type
+  {
+  };
+
+  template<size_t bits>
+  struct is_bitstream<bitstream<bits>> : std::true_type
+  {
+  };
+
+  template<typename T>
+  constexpr bool is_bitstream_v = is_bitstream<T>::value;
+} // namespace detail
+
 
 
 }
 
-#endif // !RDK_03F2F1279F55C951054ADBCFDAE92797 
+#endif // !RDK_03F2F1279F55C951054ADBCFDAE92797
@@ -0,0 +1,325 @@
+#pragma once
+#ifndef RDK_34ADAC0B597649919807368CE32250B5
+#define RDK_34ADAC0B597649919807368CE32250B5
+
+#include "cpu_features.hpp"
+#include "packer.hpp"
+#include "safe_int.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ratio>
+#include <stdexcept>
+#include <type_traits>
+
+namespace rdk
+{
+
+/// floating point value in [Min, Max] (std::ratio), quantized to multiples of Resolution away from Min
+/// stored as the code round((v - Min) / Resolution) in a safe_unsigned<0, max_code>, whose packable_traits it reuses;
+/// e.g. quantized<float, std::ratio<-50>, std::ratio<150>, std::centi> takes 15 bits and is off by
+/// at most half a centi plus the rounding error of F
+template<typename F, typename Min, typename Max, typename Resolution>
+class quantized
+{
+  static_assert(std::is_floating_point_v<F>, "quantized: value type must be a floating point type");
+  static_assert(std::ratio_less_equal_v<Min, Max>, "quantized: value range mustn't be empty");
+  static_assert(std::ratio_greater_v<Resolution, std::ratio<0>>, "quantized: resolution must be positive");
+
+  using steps = std::ratio_divide<std::ratio_subtract<Max, Min>, Resolution>;
+
+public:
+  using value_type = F;
+
+  /// largest code, i.e. the one encode rounds Max to: (Max - Min) / Resolution rounded to nearest, halves up
+  /// so decoding never exceeds Max by more than half a resolution
+  static constexpr uintmax_t max_code = ((2U * static_cast<uintmax_t>(steps::num)) + static_cast<uintmax_t>(steps::den)) / (2U * static_cast<uintmax_t>(steps::den));
+  using code_type = safe_unsigned<0U, max_code>;
+
+  static constexpr F min_value = static_cast<F>(Min::num) / static_cast<F>(Min::den);
+  static constexpr F max_value = static_cast<F>(Max::num) / static_cast<F>(Max::den);
+  static constexpr F resolution = static_cast<F>(Resolution::num) / static_cast<F>(Resolution::den);
+  /// reciprocal of the resolution
+  static constexpr F scale = static_cast<F>(Resolution::den) / static_cast<F>(Resolution::num);
+
+  quantized() = delete;
+
+  /// rounds to the nearest code, throws std::domain_error for values outside of [Min, Max] (including NaN)
+  constexpr explicit quantized(F v)
+    : c(checked_encode(v), unchecked_construct)
+  {
+  }
+
+  constexpr explicit quantized(code_type c) noexcept
+    : c(c)
+  {
+  }
+
+  constexpr explicit operator F() const noexcept
+  {
+    return decode(static_cast<typename code_type::value_type>(c));
+  }
+
+  constexpr code_type code() const noexcept
+  {
+    return c;
+  }
+
+  /// code of a value in [Min, Max]
+  static constexpr typename code_type::value_type encode(F v) noexcept
+  {
+    // truncation rounds to nearest, since the biased value isn't negative; clamped for rounding errors at Max
+    return static_cast<typename code_type::value_type>(std::min(static_cast<uintmax_t>(((v - min_value) * scale) + static_cast<F>(0.5)), max_code));
+  }
+
+  static constexpr F decode(typename code_type::value_type code) noexcept
+  {
+    return min_value + (static_cast<F>(code) * resolution);
+  }
+
+private:
+  static constexpr typename code_type::value_type checked_encode(F v)
+  {
+    if(!((v >= min_value) && (v <= max_value)))
+    {
+      detail::raise<std::domain_error>("quantized: value exceeds specified range.");
+    }
+    return encode(v);
+  }
+
+  code_type c;
+};
+
+template<typename F, typename Min, typename Max, typename Resolution>
+constexpr bool operator==(quantized<F, Min, Max, Resolution> lhs, quantized<F, Min, Max, Resolution> rhs) noexcept
+{
+  return (lhs.code() == rhs.code());
+}
+
+template<typename F, typename Min, typename Max, typename Resolution>
+constexpr bool operator!=(quantized<F, Min, Max, Resolution> lhs, quantized<F, Min, Max, Resolution> rhs) noexcept
+{
+  return !(lhs == rhs);
+}
+
+template<typename F, typename Min, typename Max, typename Resolution>
+constexpr bool operator<(quantized<F, Min, Max, Resolution> lhs, quantized<F, Min, Max, Resolution> rhs) noexcept
+{
+  return (lhs.code() < rhs.code());
+}
+
+template<typename F, typename Min, typename Max, typename Resolution>
+struct is_packable<quantized<F, Min, Max, Resolution>> : std::true_type
+{
+};
+
+template<typename F, typename Min, typename Max, typename Resolution>
+struct packable_traits<quantized<F, Min, Max, Resolution>>
+{
+  using value_type = quantized<F, Min, Max, Resolution>;
+
+private:
+  using code_traits = packable_traits<typename value_type::code_type>;
+
+public:
+  static constexpr uintmax_t packed_size = code_traits::packed_size;
+  using packed_type = typename code_traits::packed_type;
+
+  static constexpr uint64_t max_code = code_traits::max_code;
+  static constexpr bool has_niche = code_traits::has_niche;
+
+  static constexpr packed_type niche() noexcept
+  {
+    return code_traits::niche();
+  }
+
+  static constexpr bool is_niche(packed_type const &v) noexcept
+  {
+    return code_traits::is_niche(v);
+  }
+
+  static constexpr packed_type pack(value_type const &v) noexcept
+  {
+    return code_traits::pack(v.code());
+  }
+
+  static constexpr value_type unpack(packed_type const &v) noexcept
+  {
+    return value_type{code_traits::unpack(v)};
+  }
+
+  static void pack_into(std::byte *base, size_t bit_offset, value_type const &v) noexcept
+  {
+    code_traits::pack_into(base, bit_offset, v.code());
+  }
+
+  static value_type unpack_from(std::byte const *base, size_t bit_offset) noexcept
+  {
+    return value_type{code_traits::unpack_from(base, bit_offset)};
+  }
+};
+
+// bulk conversion kernels
+// vector kernels convert as many elements as they can and return how many that were, the scalar kernels take care of the rest
+// both compute the same float operations in the same order, so results are bit identical
+namespace detail
+{
+  template<typename Q>
+  struct quantized_element
+  {
+    using code_type = typename Q::code_type;
+    using native_type = typename code_type::value_type;
+    static_assert(std::is_trivially_copyable_v<code_type> && (sizeof(code_type) == sizeof(native_type)), "quantized: codes must be layout compatible with their value type");
+
+    /// the vector kernels convert floats through 32 bit integer lanes
+    static constexpr bool has_vector_kernel = std::is_same_v<typename Q::value_type, float> && (sizeof(native_type) <= 4U) && (Q::max_code <= static_cast<uintmax_t>(std::numeric_limits<int32_t>::max()));
+  };
+
+  template<typename Q>
+  void quantize_bulk_scalar(typename Q::value_type const *in, size_t n, typename Q::code_type *out) noexcept
+  {
+    for(size_t i{}; i < n; ++i)
+    {
+      out[i] = typename Q::code_type{Q::encode(in[i]), unchecked_construct};
+    }
+  }
+
+  template<typename Q>
+  void dequantize_bulk_scalar(typename Q::code_type const *in, size_t n, typename Q::value_type *out) noexcept
+  {
+    for(size_t i{}; i < n; ++i)
+    {
+      out[i] = Q::decode(static_cast<typename Q::code_type::value_type>(in[i]));
+    }
+  }
+
+#ifdef RDK_X86_64
+  /// 8 elements per iteration: rebase, scale, round, clamp and narrow to the code's native type
+  template<typename Q>
+  RDK_TARGET("avx2") size_t quantize_bulk_avx2(float const *in, size_t n, typename Q::code_type *out) noexcept
+  {
+    using element = quantized_element<Q>;
+    static_assert(element::has_vector_kernel, "quantized: no vector kernel for this type");
+    __m256 const min = _mm256_set1_ps(Q::min_value);
+    __m256 const scale = _mm256_set1_ps(Q::scale);
+    __m256 const half = _mm256_set1_ps(0.5F);
+    __m256i const max_code = _mm256_set1_epi32(static_cast<int>(Q::max_code));
+
+    size_t i{};
+    for(; (i + 8U) <= n; i += 8U)
+    {
+      __m256 const v = _mm256_add_ps(_mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(in + i), min), scale), half);
+      __m256i const codes = _mm256_min_epu32(_mm256_cvttps_epi32(v), max_code);
+      if constexpr(4U == sizeof(typename element::native_type))
+      {
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), codes);
+      }
+      else
+      {
+        // codes are at most max_code, so the saturating packs just narrow
+        __m128i const words = _mm_packus_epi32(_mm256_castsi256_si128(codes), _mm256_extracti128_si256(codes, 1));
+        if constexpr(2U == sizeof(typename element::native_type))
+        {
+          _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), words);
+        }
+        else
+        {
+          _mm_storel_epi64(reinterpret_cast<__m128i *>(out + i), _mm_packus_epi16(words, words));
+        }
+      }
+    }
+    return i;
+  }
+
+  /// 8 elements per iteration: widen the codes, convert, scale and rebase
+  template<typename Q>
+  RDK_TARGET("avx2") size_t dequantize_bulk_avx2(typename Q::code_type const *in, size_t n, float *out) noexcept
+  {
+    using element = quantized_element<Q>;
+    static_assert(element::has_vector_kernel, "quantized: no vector kernel for this type");
+    __m256 const min = _mm256_set1_ps(Q::min_value);
+    __m256 const resolution = _mm256_set1_ps(Q::resolution);
+
+    size_t i{};
+    for(; (i + 8U) <= n; i += 8U)
+    {
+      __m256i codes;
+      if constexpr(4U == sizeof(typename element::native_type))
+      {
+        codes = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(in + i));
+      }
+      else if constexpr(2U == sizeof(typename element::native_type))
+      {
+        codes = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<__m128i const *>(in + i)));
+      }
+      else
+      {
+        codes = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<__m128i const *>(in + i)));
+      }
+      _mm256_storeu_ps(out + i, _mm256_add_ps(min, _mm256_mul_ps(_mm256_cvtepi32_ps(codes), resolution)));
+    }
+    return i;
+  }
+#endif
+} // namespace detail
+
+/// quantizes n values known to be in [Min, Max] into codes
+template<typename Q>
+void quantize_bulk(typename Q::value_type const *in, size_t n, typename Q::code_type *out, unchecked_construct_t) noexcept
+{
+  assert(std::all_of(in, in + n, [](auto v) { return (v >= Q::min_value) && (v <= Q::max_value); }));
+  size_t done{};
+  if constexpr(detail::quantized_element<Q>::has_vector_kernel)
+  {
+#ifdef RDK_X86_64
+    if(detail::cpu.avx2)
+    {
+      done = detail::quantize_bulk_avx2<Q>(in, n, out);
+    }
+#endif
+  }
+  detail::quantize_bulk_scalar<Q>(in + done, n - done, out + done);
+}
+
+/// quantizes n values into codes, e.g. for pack_bulk
+/// every code is the one quantized<...>{in[i]}.code() would yield;
+/// throws std::domain_error without writing anything if any value is outside of [Min, Max] (including NaN)
+template<typename Q>
+void quantize_bulk(typename Q::value_type const *in, size_t n, typename Q::code_type *out)
+{
+  // branch free, so the check vectorizes
+  bool bad = false;
+  for(size_t i{}; i < n; ++i)
+  {
+    bad |= !((in[i] >= Q::min_value) & (in[i] <= Q::max_value));
+  }
+  if(bad)
+  {
+    detail::raise<std::domain_error>("quantized: value exceeds specified range.");
+  }
+  quantize_bulk<Q>(in, n, out, unchecked_construct);
+}
+
+/// converts n codes back to values
+template<typename Q>
+void dequantize_bulk(typename Q::code_type const *in, size_t n, typename Q::value_type *out) noexcept
+{
+  size_t done{};
+  if constexpr(detail::quantized_element<Q>::has_vector_kernel)
+  {
+#ifdef RDK_X86_64
+    if(detail::cpu.avx2)
+    {
+      done = detail::dequantize_bulk_avx2<Q>(in, n, out);
+    }
+#endif
+  }
+  detail::dequantize_bulk_scalar<Q>(in + done, n - done, out + done);
+}
+
+} // namespace rdk
+
+#endif // !RDK_34ADAC0B597649919807368CE32250B5
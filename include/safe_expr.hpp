@@ -0,0 +1,320 @@
+#pragma once
+#ifndef RDK_42329ED110E840D496E393F373E0AC17
+#define RDK_42329ED110E840D496E393F373E0AC17
+
+#include "safe_int.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace rdk
+{
+
+/// opt-in expression templates over safe integers
+/// lazy(v) (or lazy_each(p) for arrays of safe integers) starts an expression, +, - and * then capture the whole tree;
+/// eval / eval_each evaluate it once, in the narrowest native type holding every intermediate result,
+/// instead of converting to a freshly deduced type after each operation
+/// e.g. eval_each(lazy_each(a) * lazy_each(b) + lazy_each(c), n, out) compiles to a single loop with lanes that narrow
+template<typename Node>
+class safe_expr;
+
+namespace detail
+{
+  constexpr intmax_t expr_min = std::numeric_limits<intmax_t>::min();
+  constexpr intmax_t expr_max = std::numeric_limits<intmax_t>::max();
+
+  /// safe integer with the given range, unsigned if the range is non-negative
+  template<intmax_t min, intmax_t max, bool = (min >= 0)>
+  struct safe_from_range
+  {
+    using type = safe_unsigned<static_cast<uintmax_t>(min), static_cast<uintmax_t>(max)>;
+  };
+
+  template<intmax_t min, intmax_t max>
+  struct safe_from_range<min, max, false>
+  {
+    using type = safe_signed<min, max>;
+  };
+
+  /// native type holding every value in [min, max]
+  template<intmax_t min, intmax_t max>
+  using native_from_range_t = typename safe_from_range<min, max>::type::value_type;
+
+  // nodes; each knows the range of its value (min, max) and of all values in its subtree (lo, hi)
+
+  template<typename S>
+  struct expr_leaf_range
+  {
+    using value_type = typename S::value_type;
+
+    static_assert(fits_intmax_v<S>, "SafeInt: expression operands must be representable as intmax_t");
+
+    static constexpr intmax_t min = static_cast<intmax_t>(static_cast<value_type>(std::numeric_limits<S>::min()));
+    static constexpr intmax_t max = static_cast<intmax_t>(static_cast<value_type>(std::numeric_limits<S>::max()));
+    static constexpr intmax_t lo = min;
+    static constexpr intmax_t hi = max;
+  };
+
+  /// a single value
+  template<typename S>
+  struct expr_value : expr_leaf_range<S>
+  {
+    static constexpr bool elementwise = false;
+
+    S v;
+
+    template<typename C>
+    constexpr C get(size_t) const noexcept
+    {
+      return static_cast<C>(static_cast<typename S::value_type>(v));
+    }
+  };
+
+  /// element i of an array
+  template<typename S>
+  struct expr_array : expr_leaf_range<S>
+  {
+    static constexpr bool elementwise = true;
+
+    S const *p;
+
+    template<typename C>
+    constexpr C get(size_t i) const noexcept
+    {
+      return static_cast<C>(static_cast<typename S::value_type>(p[i]));
+    }
+  };
+
+  template<typename L, typename R>
+  struct expr_binary
+  {
+    static constexpr bool elementwise = (L::elementwise || R::elementwise);
+
+    L l;
+    R r;
+  };
+
+  template<typename L, typename R>
+  struct expr_add : expr_binary<L, R>
+  {
+    static_assert(((R::max <= 0) || (L::max <= (expr_max - R::max))) && ((R::min >= 0) || (L::min >= (expr_min - R::min)))
+      , "SafeInt: sum result cannot be represented using native types");
+
+    static constexpr intmax_t min = L::min + R::min;
+    static constexpr intmax_t max = L::max + R::max;
+    static constexpr intmax_t lo = std::min({L::lo, R::lo, min});
+    static constexpr intmax_t hi = std::max({L::hi, R::hi, max});
+
+    template<typename C>
+    constexpr C get(size_t i) const noexcept
+    {
+      return static_cast<C>(this->l.template get<C>(i) + this->r.template get<C>(i));
+    }
+  };
+
+  template<typename L, typename R>
+  struct expr_sub : expr_binary<L, R>
+  {
+    static_assert(((R::min >= 0) || (L::max <= (expr_max + R::min))) && ((R::max <= 0) || (L::min >= (expr_min + R::max)))
+      , "SafeInt: difference result cannot be represented using native types");
+
+    static constexpr intmax_t min = L::min - R::max;
+    static constexpr intmax_t max = L::max - R::min;
+    static constexpr intmax_t lo = std::min({L::lo, R::lo, min});
+    static constexpr intmax_t hi = std::max({L::hi, R::hi, max});
+
+    template<typename C>
+    constexpr C get(size_t i) const noexcept
+    {
+      return static_cast<C>(this->l.template get<C>(i) - this->r.template get<C>(i));
+    }
+  };
+
+  /// whether a * b is representable as intmax_t
+  constexpr bool mul_fits_intmax(intmax_t a, intmax_t b) noexcept
+  {
+    return mul_fits(static_cast<intwide_t>(a), static_cast<intwide_t>(b))
+      && (static_cast<intwide_t>(a) * static_cast<intwide_t>(b) >= expr_min) && (static_cast<intwide_t>(a) * static_cast<intwide_t>(b) <= expr_max);
+  }
+
+  template<typename L, typename R>
+  struct expr_mul : expr_binary<L, R>
+  {
+    static_assert(mul_fits_intmax(L::min, R::min) && mul_fits_intmax(L::min, R::max) && mul_fits_intmax(L::max, R::min) && mul_fits_intmax(L::max, R::max)
+      , "SafeInt: product result cannot be represented using native types");
+
+    static constexpr intmax_t min = std::min({L::min * R::min, L::min * R::max, L::max * R::min, L::max * R::max});
+    static constexpr intmax_t max = std::max({L::min * R::min, L::min * R::max, L::max * R::min, L::max * R::max});
+    static constexpr intmax_t lo = std::min({L::lo, R::lo, min});
+    static constexpr intmax_t hi = std::max({L::hi, R::hi, max});
+
+    template<typename C>
+    constexpr C get(size_t i) const noexcept
+    {
+      return static_cast<C>(this->l.template get<C>(i) * this->r.template get<C>(i));
+    }
+  };
+
+  template<typename E>
+  struct expr_negate
+  {
+    static_assert(E::min != expr_min, "SafeInt: negated result cannot be represented using native types");
+
+    static constexpr bool elementwise = E::elementwise;
+    static constexpr intmax_t min = -E::max;
+    static constexpr intmax_t max = -E::min;
+    static constexpr intmax_t lo = std::min(E::lo, min);
+    static constexpr intmax_t hi = std::max(E::hi, max);
+
+    E e;
+
+    template<typename C>
+    constexpr C get(size_t i) const noexcept
+    {
+      return static_cast<C>(C{} - e.template get<C>(i));
+    }
+  };
+
+  template<typename T>
+  struct is_safe_expr : std::false_type
+  {
+  };
+
+  template<typename Node>
+  struct is_safe_expr<safe_expr<Node>> : std::true_type
+  {
+  };
+} // namespace detail
+
+template<typename Node>
+class safe_expr
+{
+public:
+  using node_type = Node;
+
+  /// range of the expression's value
+  using result_type = typename detail::safe_from_range<Node::min, Node::max>::type;
+
+  /// native type every intermediate result is computed in
+  using compute_type = detail::native_from_range_t<Node::lo, Node::hi>;
+
+  /// whether the expression refers to arrays and is evaluated per element
+  static constexpr bool elementwise = Node::elementwise;
+
+  constexpr explicit safe_expr(Node node) noexcept
+    : node(node)
+  {
+  }
+
+  /// evaluates element i
+  constexpr result_type get(size_t i) const noexcept
+  {
+    return result_type{static_cast<typename result_type::value_type>(node.template get<compute_type>(i)), unchecked_construct};
+  }
+
+  Node node;
+};
+
+template<typename T, T min, T max, typename P>
+constexpr auto lazy(safe<T, min, max, P> v) noexcept
+{
+  using node = detail::expr_value<safe<T, min, max, P>>;
+  return safe_expr<node>{node{{}, v}};
+}
+
+/// refers to an array of safe integers, to be evaluated with eval_each
+template<typename T, T min, T max, typename P>
+constexpr auto lazy_each(safe<T, min, max, P> const *p) noexcept
+{
+  using node = detail::expr_array<safe<T, min, max, P>>;
+  return safe_expr<node>{node{{}, p}};
+}
+
+template<typename Node>
+constexpr auto eval(safe_expr<Node> const &e) noexcept
+{
+  static_assert(!safe_expr<Node>::elementwise, "SafeInt: expressions over arrays are evaluated with eval_each");
+  return e.get(0U);
+}
+
+/// evaluates an expression over arrays for the first n elements
+/// the loop body only computes in compute_type, so it vectorizes with lanes of that width
+template<typename Node>
+void eval_each(safe_expr<Node> const &e, size_t n, typename safe_expr<Node>::result_type *out) noexcept
+{
+  for(size_t i{}; i < n; ++i)
+  {
+    out[i] = e.get(i);
+  }
+}
+
+template<typename L, typename R>
+constexpr auto operator+(safe_expr<L> const &lhs, safe_expr<R> const &rhs) noexcept
+{
+  using node = detail::expr_add<L, R>;
+  return safe_expr<node>{node{{lhs.node, rhs.node}}};
+}
+
+template<typename L, typename T, T min, T max, typename P>
+constexpr auto operator+(safe_expr<L> const &lhs, safe<T, min, max, P> rhs) noexcept
+{
+  return lhs + lazy(rhs);
+}
+
+template<typename T, T min, T max, typename P, typename R>
+constexpr auto operator+(safe<T, min, max, P> lhs, safe_expr<R> const &rhs) noexcept
+{
+  return lazy(lhs) + rhs;
+}
+
+template<typename L, typename R>
+constexpr auto operator-(safe_expr<L> const &lhs, safe_expr<R> const &rhs) noexcept
+{
+  using node = detail::expr_sub<L, R>;
+  return safe_expr<node>{node{{lhs.node, rhs.node}}};
+}
+
+template<typename L, typename T, T min, T max, typename P>
+constexpr auto operator-(safe_expr<L> const &lhs, safe<T, min, max, P> rhs) noexcept
+{
+  return lhs - lazy(rhs);
+}
+
+template<typename T, T min, T max, typename P, typename R>
+constexpr auto operator-(safe<T, min, max, P> lhs, safe_expr<R> const &rhs) noexcept
+{
+  return lazy(lhs) - rhs;
+}
+
+template<typename L, typename R>
+constexpr auto operator*(safe_expr<L> const &lhs, safe_expr<R> const &rhs) noexcept
+{
+  using node = detail::expr_mul<L, R>;
+  return safe_expr<node>{node{{lhs.node, rhs.node}}};
+}
+
+template<typename L, typename T, T min, T max, typename P>
+constexpr auto operator*(safe_expr<L> const &lhs, safe<T, min, max, P> rhs) noexcept
+{
+  return lhs * lazy(rhs);
+}
+
+template<typename T, T min, T max, typename P, typename R>
+constexpr auto operator*(safe<T, min, max, P> lhs, safe_expr<R> const &rhs) noexcept
+{
+  return lazy(lhs) * rhs;
+}
+
+template<typename E>
+constexpr auto operator-(safe_expr<E> const &v) noexcept
+{
+  using node = detail::expr_negate<E>;
+  return safe_expr<node>{node{v.node}};
+}
+
+} // namespace rdk
+
+#endif // !RDK_42329ED110E840D496E393F373E0AC17
@@ -0,0 +1,247 @@
+#pragma once
+#ifndef RDK_5DCA7A4125A846C1BA02AAC9FE43AB36
+#define RDK_5DCA7A4125A846C1BA02AAC9FE43AB36
+
+#include "packer.hpp"
+#include "safe_int.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace rdk
+{
+
+/// fixed point number raw * 2^-frac_bits, where the raw integer is a safe<T, min, max>
+/// i.e. min and max bound the raw value: safe_fixed_signed<-(1 << 14), 1 << 14, 14> spans [-1, 1] in Q14
+/// results of arithmetic keep tracking the raw range, so they never need a runtime overflow check
+template<typename T, T min, T max, size_t frac_bits>
+class safe_fixed
+{
+public:
+  using value_type = T;
+  using raw_type = safe<T, min, max>;
+
+  static constexpr size_t fraction_bits = frac_bits;
+
+  safe_fixed() = delete;
+
+  constexpr explicit safe_fixed(raw_type raw) noexcept
+    : r(raw)
+  {
+  }
+
+  /// checked construction from the raw value, throws std::domain_error if it's out of range
+  constexpr explicit safe_fixed(T raw)
+    : r(raw)
+  {
+  }
+
+  constexpr explicit safe_fixed(T raw, unchecked_construct_t) noexcept
+    : r(raw, unchecked_construct)
+  {
+  }
+
+  constexpr raw_type raw() const noexcept
+  {
+    return r;
+  }
+
+  template<typename F, typename = std::enable_if_t<std::is_floating_point_v<F>>>
+  constexpr explicit operator F() const noexcept
+  {
+    return static_cast<F>(static_cast<T>(r)) / static_cast<F>(uintmax_t{1U} << frac_bits);
+  }
+
+private:
+  static_assert(frac_bits < std::numeric_limits<uintmax_t>::digits, "SafeInt: too many fraction bits");
+
+  raw_type r;
+};
+
+template<intmax_t min, intmax_t max, size_t frac_bits>
+using safe_fixed_signed = safe_fixed<typename detail::signed_type_from_range<min, max>::type, min, max, frac_bits>;
+
+template<uintmax_t min, uintmax_t max, size_t frac_bits>
+using safe_fixed_unsigned = safe_fixed<typename detail::unsigned_type_from_range<min, max>::type, min, max, frac_bits>;
+
+// fixed point helpers
+namespace detail
+{
+  template<typename S, size_t frac_bits>
+  using safe_fixed_from_raw_t = safe_fixed<typename S::value_type, static_cast<typename S::value_type>(std::numeric_limits<S>::min()), static_cast<typename S::value_type>(std::numeric_limits<S>::max()), frac_bits>;
+} // namespace detail
+
+/// converts to frac_bits fraction bits; dropped fraction bits round towards negative infinity
+template<size_t frac_bits, typename T, T min, T max, size_t from_bits>
+constexpr auto rescale(safe_fixed<T, min, max, from_bits> v) noexcept
+{
+  constexpr size_t shift = (frac_bits > from_bits) ? (frac_bits - from_bits) : (from_bits - frac_bits);
+  using amount = safe_unsigned<shift, shift>;
+  if constexpr(frac_bits > from_bits)
+  {
+    auto const raw = v.raw() << amount{static_cast<typename amount::value_type>(shift), unchecked_construct};
+    return detail::safe_fixed_from_raw_t<decltype(raw), frac_bits>{raw};
+  }
+  else
+  {
+    auto const raw = v.raw() >> amount{static_cast<typename amount::value_type>(shift), unchecked_construct};
+    return detail::safe_fixed_from_raw_t<decltype(raw), frac_bits>{raw};
+  }
+}
+
+template
+<
+  typename T, T minT, T maxT, size_t fracT
+, typename U, U minU, U maxU, size_t fracU
+>
+constexpr auto operator+(safe_fixed<T, minT, maxT, fracT> lhs, safe_fixed<U, minU, maxU, fracU> rhs) noexcept
+{
+  constexpr size_t frac_bits = std::max(fracT, fracU);
+  auto const sum = rescale<frac_bits>(lhs).raw() + rescale<frac_bits>(rhs).raw();
+  return detail::safe_fixed_from_raw_t<decltype(sum), frac_bits>{sum};
+}
+
+template
+<
+  typename T, T minT, T maxT, size_t fracT
+, typename U, U minU, U maxU, size_t fracU
+>
+constexpr auto operator-(safe_fixed<T, minT, maxT, fracT> lhs, safe_fixed<U, minU, maxU, fracU> rhs) noexcept
+{
+  constexpr size_t frac_bits = std::max(fracT, fracU);
+  auto const diff = rescale<frac_bits>(lhs).raw() - rescale<frac_bits>(rhs).raw();
+  return detail::safe_fixed_from_raw_t<decltype(diff), frac_bits>{diff};
+}
+
+/// exact product, with the sum of both operands' fraction bits; rescale it to drop some of them
+template
+<
+  typename T, T minT, T maxT, size_t fracT
+, typename U, U minU, U maxU, size_t fracU
+>
+constexpr auto operator*(safe_fixed<T, minT, maxT, fracT> lhs, safe_fixed<U, minU, maxU, fracU> rhs) noexcept
+{
+  auto const product = lhs.raw() * rhs.raw();
+  return detail::safe_fixed_from_raw_t<decltype(product), fracT + fracU>{product};
+}
+
+/// compares at the finer resolution of both operands; the other comparisons are derived from this one
+template
+<
+  typename T, T minT, T maxT, size_t fracT
+, typename U, U minU, U maxU, size_t fracU
+>
+constexpr bool operator<(safe_fixed<T, minT, maxT, fracT> lhs, safe_fixed<U, minU, maxU, fracU> rhs)
+{
+  constexpr size_t frac_bits = std::max(fracT, fracU);
+  return (rescale<frac_bits>(lhs).raw() < rescale<frac_bits>(rhs).raw());
+}
+
+template
+<
+  typename T, T minT, T maxT, size_t fracT
+, typename U, U minU, U maxU, size_t fracU
+>
+constexpr bool operator>(safe_fixed<T, minT, maxT, fracT> lhs, safe_fixed<U, minU, maxU, fracU> rhs)
+{
+  return (rhs < lhs);
+}
+
+template
+<
+  typename T, T minT, T maxT, size_t fracT
+, typename U, U minU, U maxU, size_t fracU
+>
+constexpr bool operator>=(safe_fixed<T, minT, maxT, fracT> lhs, safe_fixed<U, minU, maxU, fracU> rhs)
+{
+  return !(lhs < rhs);
+}
+
+template
+<
+  typename T, T minT, T maxT, size_t fracT
+, typename U, U minU, U maxU, size_t fracU
+>
+constexpr bool operator<=(safe_fixed<T, minT, maxT, fracT> lhs, safe_fixed<U, minU, maxU, fracU> rhs)
+{
+  return !(rhs < lhs);
+}
+
+template
+<
+  typename T, T minT, T maxT, size_t fracT
+, typename U, U minU, U maxU, size_t fracU
+>
+constexpr bool operator==(safe_fixed<T, minT, maxT, fracT> lhs, safe_fixed<U, minU, maxU, fracU> rhs)
+{
+  return (!(lhs < rhs) && !(rhs < lhs));
+}
+
+template
+<
+  typename T, T minT, T maxT, size_t fracT
+, typename U, U minU, U maxU, size_t fracU
+>
+constexpr bool operator!=(safe_fixed<T, minT, maxT, fracT> lhs, safe_fixed<U, minU, maxU, fracU> rhs)
+{
+  return !(lhs == rhs);
+}
+
+template<typename T, T min, T max, size_t frac_bits>
+struct is_packable<safe_fixed<T, min, max, frac_bits>> : std::true_type
+{
+};
+
+/// packed as the raw value
+template<typename T, T min, T max, size_t frac_bits>
+struct packable_traits<safe_fixed<T, min, max, frac_bits>>
+{
+  using value_type = safe_fixed<T, min, max, frac_bits>;
+
+private:
+  using raw_traits = packable_traits<safe<T, min, max>>;
+
+public:
+  static constexpr uintmax_t packed_size = raw_traits::packed_size;
+  using packed_type = typename raw_traits::packed_type;
+
+  static constexpr uint64_t max_code = raw_traits::max_code;
+  static constexpr bool has_niche = raw_traits::has_niche;
+
+  static constexpr packed_type niche() noexcept
+  {
+    return raw_traits::niche();
+  }
+
+  static constexpr bool is_niche(packed_type const &v) noexcept
+  {
+    return raw_traits::is_niche(v);
+  }
+
+  static constexpr packed_type pack(value_type const &v) noexcept
+  {
+    return raw_traits::pack(v.raw());
+  }
+
+  static constexpr value_type unpack(packed_type const &v) noexcept
+  {
+    return value_type{raw_traits::unpack(v)};
+  }
+
+  static void pack_into(std::byte *base, size_t bit_offset, value_type const &v) noexcept
+  {
+    raw_traits::pack_into(base, bit_offset, v.raw());
+  }
+
+  static value_type unpack_from(std::byte const *base, size_t bit_offset) noexcept
+  {
+    return value_type{raw_traits::unpack_from(base, bit_offset)};
+  }
+};
+
+} // namespace rdk
+
+#endif // !RDK_5DCA7A4125A846C1BA02AAC9FE43AB36
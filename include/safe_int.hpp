@@ -4,6 +4,10 @@
 
 #include "packer.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
 #include <cstdint>
 #include <limits>
 #include <stdexcept>
@@ -17,24 +21,326 @@ struct unchecked_construct_t
 };
 constexpr unchecked_construct_t unchecked_construct{};
 
-template<typename T, T min, T max>
+// native integer helpers
+// std traits only know about 128 bit integers in GNU mode, these cover them in strict ISO mode as well
+namespace detail
+{
+  /// widest native types, ranges are computed in these
+#ifdef RDK_HAS_INT128
+  using intwide_t = int128_t;
+  using uintwide_t = uint128_t;
+#else
+  using intwide_t = intmax_t;
+  using uintwide_t = uintmax_t;
+#endif
+
+  template<typename T>
+  struct integer_limits : std::numeric_limits<T>
+  {
+  };
+
+  template<typename T>
+  struct make_unsigned : std::make_unsigned<T>
+  {
+  };
+
+#ifdef RDK_HAS_INT128
+  template<typename T>
+  struct wide_integer_limits
+  {
+    static constexpr bool is_specialized = true;
+    static constexpr bool is_signed = std::is_same_v<T, int128_t>;
+    static constexpr bool is_integer = true;
+    static constexpr bool is_exact = true;
+    static constexpr int radix = 2;
+    static constexpr int digits = is_signed ? 127 : 128;
+
+    static constexpr T max() noexcept
+    {
+      return static_cast<T>(~uint128_t{} >> (is_signed ? 1U : 0U));
+    }
+
+    static constexpr T min() noexcept
+    {
+      return is_signed ? static_cast<T>(-max() - 1) : T{};
+    }
+
+    static constexpr T lowest() noexcept
+    {
+      return min();
+    }
+  };
+
+  template<>
+  struct integer_limits<int128_t> : wide_integer_limits<int128_t>
+  {
+  };
+
+  template<>
+  struct integer_limits<uint128_t> : wide_integer_limits<uint128_t>
+  {
+  };
+
+  template<>
+  struct make_unsigned<int128_t>
+  {
+    using type = uint128_t;
+  };
+
+  template<>
+  struct make_unsigned<uint128_t>
+  {
+    using type = uint128_t;
+  };
+#endif
+
+  template<typename T>
+  using make_unsigned_t = typename make_unsigned<T>::type;
+} // namespace detail
+
+// mixed sign comparisons of native values, comp<T, U>::call(lhs, rhs) is lhs < rhs
+namespace detail
+{
+  template<typename T, typename U, bool = integer_limits<T>::is_signed, bool = integer_limits<U>::is_signed>
+  struct comp;
+
+  template<typename T, typename U>
+  struct comp<T, U, false, false>
+  {
+    static constexpr bool call(T lhs, U rhs)
+    {
+      return (lhs < rhs);
+    }
+  };
+
+  template<typename T, typename U>
+  struct comp<T, U, true, true>
+  {
+    static constexpr bool call(T lhs, U rhs)
+    {
+      return (lhs < rhs);
+    }
+  };
+
+  template<typename T, typename U>
+  struct comp<T, U, true, false>
+  {
+    static constexpr bool call(T lhs, U rhs)
+    {
+      return (lhs < T{}) ? true : (static_cast<make_unsigned_t<T>>(lhs) < rhs);
+    }
+  };
+
+  template<typename T, typename U>
+  struct comp<T, U, false, true>
+  {
+    static constexpr bool call(T lhs, U rhs)
+    {
+      return (rhs < U{}) ? false : (lhs < static_cast<make_unsigned_t<U>>(rhs));
+    }
+  };
+
+  /// whether v is in [min, max]
+  /// a single compare of the unsigned distance from min, which is exact as long as all of U and [min, max]
+  /// either are non-negative or fit into the signed type of the same width
+  template<typename T, T min, T max, typename U>
+  constexpr bool in_range(U v) noexcept
+  {
+    constexpr bool narrow = (std::max(sizeof(T), sizeof(U)) <= sizeof(uintmax_t));
+    using distance_type = std::conditional_t<narrow, uintmax_t, uintwide_t>;
+    using signed_type = std::conditional_t<narrow, intmax_t, intwide_t>;
+
+    constexpr bool signed_window = !comp<signed_type, U>::call(integer_limits<signed_type>::max(), integer_limits<U>::max())
+      && !comp<signed_type, T>::call(integer_limits<signed_type>::max(), max);
+    constexpr bool unsigned_window = !integer_limits<U>::is_signed && !comp<T, int>::call(min, 0);
+    if constexpr(signed_window || unsigned_window)
+    {
+      return (static_cast<distance_type>(v) - static_cast<distance_type>(min)) <= (static_cast<distance_type>(max) - static_cast<distance_type>(min));
+    }
+    else
+    {
+      return !comp<U, T>::call(v, min) && !comp<T, U>::call(max, v);
+    }
+  }
+} // namespace detail
+
+/// error policies decide what checked construction, ++ and -- do with values outside of [min, max]
+/// a policy provides
+///   static constexpr bool nothrow, whether errors are handled without throwing
+///   template<typename T, T min, T max, typename U> static constexpr T check(U v), the value to store for v
+///   template<typename T, T min, T max> static constexpr T next(T v), the value to store for ++v
+///   template<typename T, T min, T max> static constexpr T prev(T v), the value to store for --v
+/// check is passed values of T or, on conversion, of a safe integer whose range overlaps [min, max]
+/// results of arithmetic never leave their deduced range and use the default policy
+namespace detail
+{
+  /// policies which hand errors to Report::report() and, if that returns, saturate
+  /// the range check is a single branch to the out of line report
+  template<typename Report>
+  struct reporting_policy
+  {
+    template<typename T, T min, T max, typename U>
+    static constexpr T check(U v) noexcept(Report::nothrow)
+    {
+      if(!in_range<T, min, max>(v))
+      {
+        Report::report();
+        return comp<U, T>::call(v, min) ? min : max;
+      }
+      return static_cast<T>(v);
+    }
+
+    template<typename T, T min, T max>
+    static constexpr T next(T v) noexcept(Report::nothrow)
+    {
+      if(max == v)
+      {
+        Report::report();
+        return v;
+      }
+      return static_cast<T>(v + 1);
+    }
+
+    template<typename T, T min, T max>
+    static constexpr T prev(T v) noexcept(Report::nothrow)
+    {
+      if(min == v)
+      {
+        Report::report();
+        return v;
+      }
+      return static_cast<T>(v - 1);
+    }
+  };
+} // namespace detail
+
+/// throws std::domain_error, the default
+/// terminates instead when compiled without exceptions
+struct throw_on_error : detail::reporting_policy<throw_on_error>
+{
+#ifdef RDK_HAS_EXCEPTIONS
+  static constexpr bool nothrow = false;
+#else
+  static constexpr bool nothrow = true;
+#endif
+
+  [[noreturn]] static void report()
+  {
+    detail::raise<std::domain_error>("SafeInt: value exceeds specified range.");
+  }
+};
+
+/// calls std::terminate
+struct terminate_on_error : detail::reporting_policy<terminate_on_error>
+{
+  static constexpr bool nothrow = true;
+
+  [[noreturn]] RDK_COLD static void report() noexcept
+  {
+    std::terminate();
+  }
+};
+
+/// counts errors in errors and saturates; there's one counter per Tag
+template<typename Tag = void>
+struct count_on_error : detail::reporting_policy<count_on_error<Tag>>
+{
+  static constexpr bool nothrow = true;
+
+  static inline std::atomic<uint64_t> errors{};
+
+  RDK_COLD static void report() noexcept
+  {
+    (void)errors.fetch_add(1U, std::memory_order_relaxed);
+  }
+};
+
+/// clamps to the range, without branches
+struct saturate_on_error
+{
+  static constexpr bool nothrow = true;
+
+  template<typename T, T min, T max, typename U>
+  static constexpr T check(U v) noexcept
+  {
+    if constexpr(std::is_same_v<T, U>)
+    {
+      return std::min(std::max(v, min), max);
+    }
+    else
+    {
+      return detail::comp<U, T>::call(v, min) ? min : (detail::comp<T, U>::call(max, v) ? max : static_cast<T>(v));
+    }
+  }
+
+  template<typename T, T min, T max>
+  static constexpr T next(T v) noexcept
+  {
+    return static_cast<T>(v + static_cast<T>(max != v));
+  }
+
+  template<typename T, T min, T max>
+  static constexpr T prev(T v) noexcept
+  {
+    return static_cast<T>(v - static_cast<T>(min != v));
+  }
+};
+
+/// wraps around modulo the range size, i.e. max + 1 yields min
+struct wrap_on_error
+{
+  static constexpr bool nothrow = true;
+
+  template<typename T, T min, T max, typename U>
+  static constexpr T check(U v) noexcept
+  {
+    // differences are taken as unsigned, which is exact since the source range overlaps [min, max]
+    // the range size is 0 if the range covers all of uintwide_t, then truncation wraps already
+    using detail::uintwide_t;
+    constexpr auto size = static_cast<uintwide_t>(static_cast<uintwide_t>(max) - static_cast<uintwide_t>(min) + 1U);
+    if constexpr(0U == size)
+    {
+      return static_cast<T>(v);
+    }
+    else if(detail::comp<U, T>::call(v, min))
+    {
+      return static_cast<T>(static_cast<uintwide_t>(max) - ((static_cast<uintwide_t>(min) - static_cast<uintwide_t>(v) - 1U) % size));
+    }
+    else
+    {
+      return static_cast<T>(static_cast<uintwide_t>(min) + ((static_cast<uintwide_t>(v) - static_cast<uintwide_t>(min)) % size));
+    }
+  }
+
+  template<typename T, T min, T max>
+  static constexpr T next(T v) noexcept
+  {
+    return (max == v) ? min : static_cast<T>(v + 1);
+  }
+
+  template<typename T, T min, T max>
+  static constexpr T prev(T v) noexcept
+  {
+    return (min == v) ? max : static_cast<T>(v - 1);
+  }
+};
+
+template<typename T, T min, T max, typename Policy = throw_on_error>
 class safe
 {
 public:
   using value_type = T;
+  using policy_type = Policy;
 
   /// no default construction
-  /// use optional<safe<...>> to get a default constructible
-  /// type at the expense of one bit storage
+  /// use optional<safe<...>> to get a default constructible type, packing it
+  /// costs one extra bit only if the range fills its whole code space
   safe() = delete;
 
-  constexpr explicit safe(T v)
-    : v(v)
+  /// checked construction; values out of range are handled by Policy
+  constexpr explicit safe(T v) noexcept(Policy::nothrow)
+    : v(Policy::template check<T, min, max>(v))
   {
-    if((v < min) || (v > max))
-    {
-      throw std::domain_error("SafeInt: value exceeds specified range.");
-    }
   }
 
   /// unchecked construction; asserts the value is in range instead of checking it and throwing on error
@@ -45,22 +351,12 @@ public:
     assert((v >= min) && (v <= max));
   }
 
-  template<typename U, U min2, U max2>
-  constexpr safe(safe<U, min2, max2> const &other) noexcept((min2 >= min) && (max2 <= max))
+  /// conversion from other safe integers; checked by Policy only if [min2, max2] isn't contained in [min, max]
+  template<typename U, U min2, U max2, typename Policy2>
+  constexpr safe(safe<U, min2, max2, Policy2> const &other) noexcept(contains<U, min2, max2> || Policy::nothrow)
+    : v(convert<U, min2, max2>(other.v))
   {
-    static_assert((min <= max2) && (max >= min2), "SafeInt: value cannot be constructed from the specified type");
-
-    constexpr bool bad_cast = false
-      || ((min2 < min) && (other.v < min))
-      || ((max2 > max) && (other.v > max))
-      ;
-
-    if(bad_cast)
-    {
-      throw std::domain_error("SafeInt: value exceeds specified range.");
-    }
-
-    v = static_cast<T>(other.v);
+    static_assert(!detail::comp<U, T>::call(max2, min) && !detail::comp<T, U>::call(max, min2), "SafeInt: value cannot be constructed from the specified type");
   }
 
   constexpr explicit operator T() const noexcept
@@ -68,36 +364,26 @@ public:
     return v;
   }
 
-  constexpr safe &operator++()
+  constexpr safe &operator++() noexcept(Policy::nothrow)
   {
-    if(max == v)
-    {
-      throw std::domain_error("SafeInt: value exceeds specified range.");
-    }
-
-    (void)++v;
+    v = Policy::template next<T, min, max>(v);
     return *this;
   }
 
-  constexpr safe operator++(int)
+  constexpr safe operator++(int) noexcept(Policy::nothrow)
   {
     auto res = *this;
     (void)++*this;
     return res;
   }
 
-  constexpr safe &operator--()
+  constexpr safe &operator--() noexcept(Policy::nothrow)
   {
-    if(min == v)
-    {
-      throw std::domain_error("SafeInt: value exceeds specified range.");
-    }
-
-    (void)--v;
+    v = Policy::template prev<T, min, max>(v);
     return *this;
   }
 
-  constexpr safe operator--(int)
+  constexpr safe operator--(int) noexcept(Policy::nothrow)
   {
     auto res = *this;
     (void)--*this;
@@ -114,13 +400,92 @@ public:
     return (safe<T, T{}, T{}>{T{}, unchecked_construct} - *this);
   }
 
-  // @@@TODO: do we want to define operator~ for unsigned types? (could be awkward with deduced underlying types)
+  // operator~ is a free function, it yields -v - 1 for unsigned types as well
+
+  /// compound assignments compute the result in its derived range, then convert it back
+  /// which needs no check if the derived range fits into [min, max] and a single compare otherwise
+  template<typename U>
+  constexpr safe &operator+=(U const &rhs) noexcept(noexcept(safe(std::declval<safe const &>() + rhs)))
+  {
+    return (*this = safe(*this + rhs));
+  }
+
+  template<typename U>
+  constexpr safe &operator-=(U const &rhs) noexcept(noexcept(safe(std::declval<safe const &>() - rhs)))
+  {
+    return (*this = safe(*this - rhs));
+  }
+
+  template<typename U>
+  constexpr safe &operator*=(U const &rhs) noexcept(noexcept(safe(std::declval<safe const &>() * rhs)))
+  {
+    return (*this = safe(*this * rhs));
+  }
+
+  template<typename U>
+  constexpr safe &operator/=(U const &rhs) noexcept(noexcept(safe(std::declval<safe const &>() / rhs)))
+  {
+    return (*this = safe(*this / rhs));
+  }
+
+  template<typename U>
+  constexpr safe &operator%=(U const &rhs) noexcept(noexcept(safe(std::declval<safe const &>() % rhs)))
+  {
+    return (*this = safe(*this % rhs));
+  }
+
+  template<typename U>
+  constexpr safe &operator&=(U const &rhs) noexcept(noexcept(safe(std::declval<safe const &>() & rhs)))
+  {
+    return (*this = safe(*this & rhs));
+  }
+
+  template<typename U>
+  constexpr safe &operator|=(U const &rhs) noexcept(noexcept(safe(std::declval<safe const &>() | rhs)))
+  {
+    return (*this = safe(*this | rhs));
+  }
+
+  template<typename U>
+  constexpr safe &operator^=(U const &rhs) noexcept(noexcept(safe(std::declval<safe const &>() ^ rhs)))
+  {
+    return (*this = safe(*this ^ rhs));
+  }
+
+  template<typename U>
+  constexpr safe &operator<<=(U const &rhs) noexcept(noexcept(safe(std::declval<safe const &>() << rhs)))
+  {
+    return (*this = safe(*this << rhs));
+  }
+
+  template<typename U>
+  constexpr safe &operator>>=(U const &rhs) noexcept(noexcept(safe(std::declval<safe const &>() >> rhs)))
+  {
+    return (*this = safe(*this >> rhs));
+  }
 
 private:
-  static_assert(std::is_integral_v<T>, "SafeInt: underlying storage must be an integral type");
+  /// whether every value in [min2, max2] is in range
+  template<typename U, U min2, U max2>
+  static constexpr bool contains = !detail::comp<U, T>::call(min2, min) && !detail::comp<T, U>::call(max, max2);
+
+  template<typename U, U min2, U max2>
+  static constexpr T convert(U v) noexcept(contains<U, min2, max2> || Policy::nothrow)
+  {
+    if constexpr(contains<U, min2, max2>)
+    {
+      return static_cast<T>(v);
+    }
+    else
+    {
+      return Policy::template check<T, min, max>(v);
+    }
+  }
+
+  static_assert(detail::integer_limits<T>::is_integer, "SafeInt: underlying storage must be an integral type");
   static_assert(min <= max, "SafeInt: value range mustn't be empty");
 
-  template<class U, U, U>
+  template<class U, U, U, typename>
   friend class safe;
 
   T v;
@@ -134,19 +499,37 @@ namespace detail
   {
   };
 
-  template<typename T, T min, T max>
-  struct is_safe<safe<T, min, max>> : std::true_type
+  template<typename T, T min, T max, typename P>
+  struct is_safe<safe<T, min, max, P>> : std::true_type
   {
   };
 
   template<typename T>
   constexpr bool is_safe_v = is_safe<T>::value;
+
+  /// whether every value of S is representable as intmax_t, respectively as uintmax_t
+  /// operators that don't support wide ranges compute in these
+  template<typename S>
+  constexpr bool fits_intmax_v = !comp<typename S::value_type, intmax_t>::call(static_cast<typename S::value_type>(std::numeric_limits<S>::min()), std::numeric_limits<intmax_t>::min())
+    && !comp<intmax_t, typename S::value_type>::call(std::numeric_limits<intmax_t>::max(), static_cast<typename S::value_type>(std::numeric_limits<S>::max()));
+
+  template<typename S>
+  constexpr bool fits_uintmax_v = !comp<uintmax_t, typename S::value_type>::call(std::numeric_limits<uintmax_t>::max(), static_cast<typename S::value_type>(std::numeric_limits<S>::max()));
 } // namespace detail
 
 // type deduction helpers
 namespace detail
 {
-  template<intmax_t min, intmax_t max>
+  /// storage for ranges exceeding 64 bits, if there is any
+#ifdef RDK_HAS_INT128
+  using signed_wide_storage = int128_t;
+  using unsigned_wide_storage = uint128_t;
+#else
+  using signed_wide_storage = void;
+  using unsigned_wide_storage = void;
+#endif
+
+  template<intwide_t min, intwide_t max>
   struct signed_type_from_range
   {
     using type = std::conditional_t
@@ -165,14 +548,14 @@ namespace detail
           <
             ((min >= std::numeric_limits<int64_t>::min()) && (max <= std::numeric_limits<int64_t>::max()))
           , int64_t
-          , void
+          , signed_wide_storage
           >
         >
       >
     >;
   };
 
-  template<uintmax_t min, uintmax_t max>
+  template<uintwide_t min, uintwide_t max>
   struct unsigned_type_from_range
   {
     using type = std::conditional_t
@@ -191,7 +574,7 @@ namespace detail
           <
             ((min >= std::numeric_limits<uint64_t>::min()) && (max <= std::numeric_limits<uint64_t>::max()))
           , uint64_t
-          , void
+          , unsigned_wide_storage
           >
         >
       >
@@ -199,54 +582,13 @@ namespace detail
   };
 } // namespace detail
 
-template<intmax_t min, intmax_t max>
-using safe_signed = safe<typename detail::signed_type_from_range<min, max>::type, min, max>;
+template<detail::intwide_t min, detail::intwide_t max, typename Policy = throw_on_error>
+using safe_signed = safe<typename detail::signed_type_from_range<min, max>::type, min, max, Policy>;
 
-template<uintmax_t min, uintmax_t max>
-using safe_unsigned = safe<typename detail::unsigned_type_from_range<min, max>::type, min, max>;
+template<detail::uintwide_t min, detail::uintwide_t max, typename Policy = throw_on_error>
+using safe_unsigned = safe<typename detail::unsigned_type_from_range<min, max>::type, min, max, Policy>;
 
 // comparison operators
-namespace detail
-{
-  template<typename T, typename U, bool = std::is_signed_v<T>, bool = std::is_signed_v<U>>
-  struct comp;
-
-  template<typename T, typename U>
-  struct comp<T, U, false, false>
-  {
-    static constexpr bool call(T lhs, U rhs)
-    {
-      return (lhs < rhs);
-    }
-  };
-
-  template<typename T, typename U>
-  struct comp<T, U, true, true>
-  {
-    static constexpr bool call(T lhs, U rhs)
-    {
-      return (lhs < rhs);
-    }
-  };
-
-  template<typename T, typename U>
-  struct comp<T, U, true, false>
-  {
-    static constexpr bool call(T lhs, U rhs)
-    {
-      return (lhs < T{}) ? true : (static_cast<std::make_unsigned_t<T>>(lhs) < rhs);
-    }
-  };
-
-  template<typename T, typename U>
-  struct comp<T, U, false, true>
-  {
-    static constexpr bool call(T lhs, U rhs)
-    {
-      return (rhs < U{}) ? false : (lhs < static_cast<std::make_unsigned_t<U>>(rhs));
-    }
-  };
-}
 
 template
 <
@@ -290,7 +632,7 @@ template
 >
 constexpr bool operator<=(T lhs, U rhs)
 {
-  return !(lhs >= rhs);
+  return !(rhs < lhs);
 }
 
 template
@@ -322,7 +664,7 @@ namespace detail
   <
     typename T
   , typename U
-  , bool = (std::is_signed_v<typename T::value_type> || std::is_signed_v<typename U::value_type>)
+  , bool = (integer_limits<typename T::value_type>::is_signed || integer_limits<typename U::value_type>::is_signed)
   >
   struct add;
 
@@ -332,8 +674,8 @@ namespace detail
     using limits_lhs = std::numeric_limits<T>;
     using limits_rhs = std::numeric_limits<U>;
 
-    static constexpr auto min = std::numeric_limits<intmax_t>::min();
-    static constexpr auto max = std::numeric_limits<intmax_t>::max();
+    static constexpr auto min = integer_limits<intwide_t>::min();
+    static constexpr auto max = integer_limits<intwide_t>::max();
 
     static constexpr auto lmin = static_cast<typename T::value_type>(limits_lhs::min());
     static constexpr auto lmax = static_cast<typename T::value_type>(limits_lhs::max());
@@ -348,8 +690,8 @@ namespace detail
       && ((lmin > 0) || (rmin >= (min - lmin)))
       , "SafeInt: sum result cannot be represented using native types");
 
-    static constexpr intmax_t newmin = static_cast<intmax_t>(lmin) + static_cast<intmax_t>(rmin);
-    static constexpr intmax_t newmax = static_cast<intmax_t>(lmax) + static_cast<intmax_t>(rmax);
+    static constexpr intwide_t newmin = static_cast<intwide_t>(lmin) + static_cast<intwide_t>(rmin);
+    static constexpr intwide_t newmax = static_cast<intwide_t>(lmax) + static_cast<intwide_t>(rmax);
 
     using result_type = safe_signed<newmin, newmax>;
     using value_type = typename result_type::value_type;
@@ -369,7 +711,7 @@ namespace detail
     using limits_lhs = std::numeric_limits<T>;
     using limits_rhs = std::numeric_limits<U>;
 
-    static constexpr auto max = std::numeric_limits<uintmax_t>::max();
+    static constexpr auto max = integer_limits<uintwide_t>::max();
 
     static constexpr auto lmin = static_cast<typename T::value_type>(limits_lhs::min());
     static constexpr auto lmax = static_cast<typename T::value_type>(limits_lhs::max());
@@ -381,8 +723,8 @@ namespace detail
     static_assert(rmax <= (max - lmax)
       , "SafeInt: sum result cannot be represented using native types");
 
-    static constexpr uintmax_t newmin = static_cast<uintmax_t>(lmin) + static_cast<uintmax_t>(rmin);
-    static constexpr uintmax_t newmax = static_cast<uintmax_t>(lmax) + static_cast<uintmax_t>(rmax);
+    static constexpr uintwide_t newmin = static_cast<uintwide_t>(lmin) + static_cast<uintwide_t>(rmin);
+    static constexpr uintwide_t newmax = static_cast<uintwide_t>(lmax) + static_cast<uintwide_t>(rmax);
 
     using result_type = safe_unsigned<newmin, newmax>;
     using value_type = typename result_type::value_type;
@@ -415,7 +757,7 @@ namespace detail
   <
     typename T
   , typename U
-  , bool = (std::is_signed_v<typename T::value_type> || std::is_signed_v<typename U::value_type> || (std::numeric_limits<T>::min() >= std::numeric_limits<U>::max()))
+  , bool = (integer_limits<typename T::value_type>::is_signed || integer_limits<typename U::value_type>::is_signed || (std::numeric_limits<T>::min() < std::numeric_limits<U>::max()))
   >
   struct sub;
 
@@ -425,8 +767,8 @@ namespace detail
     using limits_lhs = std::numeric_limits<T>;
     using limits_rhs = std::numeric_limits<U>;
 
-    static constexpr auto min = std::numeric_limits<intmax_t>::min();
-    static constexpr auto max = std::numeric_limits<intmax_t>::max();
+    static constexpr auto min = integer_limits<intwide_t>::min();
+    static constexpr auto max = integer_limits<intwide_t>::max();
 
     static constexpr auto lmin = static_cast<typename T::value_type>(limits_lhs::min());
     static constexpr auto lmax = static_cast<typename T::value_type>(limits_lhs::max());
@@ -441,8 +783,8 @@ namespace detail
       && ((rmin > 0) || (lmax <= (max + rmin)))
       , "SafeInt: sum result cannot be represented using native types");
 
-    static constexpr intmax_t newmin = static_cast<intmax_t>(lmin) - static_cast<intmax_t>(rmax);
-    static constexpr intmax_t newmax = static_cast<intmax_t>(lmax) - static_cast<intmax_t>(rmin);
+    static constexpr intwide_t newmin = static_cast<intwide_t>(lmin) - static_cast<intwide_t>(rmax);
+    static constexpr intwide_t newmax = static_cast<intwide_t>(lmax) - static_cast<intwide_t>(rmin);
 
     using result_type = safe_signed<newmin, newmax>;
     using value_type = typename result_type::value_type;
@@ -471,8 +813,8 @@ namespace detail
     // we only select this overload if lmin >= rmax, so the result cannot underflow
     // both types are unsigned, so the difference cannot overflow
 
-    static constexpr uintmax_t newmin = static_cast<uintmax_t>(lmin) - static_cast<uintmax_t>(rmax);
-    static constexpr uintmax_t newmax = static_cast<uintmax_t>(lmax) - static_cast<uintmax_t>(rmin);
+    static constexpr uintwide_t newmin = static_cast<uintwide_t>(lmin) - static_cast<uintwide_t>(rmax);
+    static constexpr uintwide_t newmax = static_cast<uintwide_t>(lmax) - static_cast<uintwide_t>(rmin);
 
     using result_type = safe_unsigned<newmin, newmax>;
     using value_type = typename result_type::value_type;
@@ -498,56 +840,845 @@ constexpr auto operator-(T lhs, U rhs) noexcept
   return detail::sub<T, U>::call(lhs, rhs);
 }
 
-template<typename T, T min, T max>
-struct is_packable<safe<T, min, max>> : std::true_type
+// multiplication helpers
+// the result range is spanned by the four corner products
+namespace detail
+{
+  /// whether a * b is representable
+  constexpr bool mul_fits(intwide_t a, intwide_t b) noexcept
+  {
+    constexpr auto min = integer_limits<intwide_t>::min();
+    constexpr auto max = integer_limits<intwide_t>::max();
+    if((0 == a) || (0 == b))
+    {
+      return true;
+    }
+    if(a > 0)
+    {
+      return (b > 0) ? (b <= (max / a)) : (b >= (min / a));
+    }
+    return (b > 0) ? (a >= (min / b)) : (b >= (max / a));
+  }
+
+  constexpr bool mul_fits(uintwide_t a, uintwide_t b) noexcept
+  {
+    return (0U == a) || (b <= (integer_limits<uintwide_t>::max() / a));
+  }
+
+  /// unsigned type the product is computed in, wide types only for results that need them
+  template<typename V>
+  using product_type = std::conditional_t<(sizeof(V) <= sizeof(uintmax_t)), uintmax_t, uintwide_t>;
+
+  template
+  <
+    typename T
+  , typename U
+  , bool = (integer_limits<typename T::value_type>::is_signed || integer_limits<typename U::value_type>::is_signed)
+  >
+  struct mul;
+
+  template<typename T, typename U>
+  struct mul<T, U, true>
+  {
+    static constexpr auto max = integer_limits<intwide_t>::max();
+
+    static constexpr auto lmin = static_cast<typename T::value_type>(std::numeric_limits<T>::min());
+    static constexpr auto lmax = static_cast<typename T::value_type>(std::numeric_limits<T>::max());
+
+    static constexpr auto rmin = static_cast<typename U::value_type>(std::numeric_limits<U>::min());
+    static constexpr auto rmax = static_cast<typename U::value_type>(std::numeric_limits<U>::max());
+
+    static_assert(true
+      && ((lmax <= max) && (rmax <= max))
+      && mul_fits(static_cast<intwide_t>(lmin), static_cast<intwide_t>(rmin))
+      && mul_fits(static_cast<intwide_t>(lmin), static_cast<intwide_t>(rmax))
+      && mul_fits(static_cast<intwide_t>(lmax), static_cast<intwide_t>(rmin))
+      && mul_fits(static_cast<intwide_t>(lmax), static_cast<intwide_t>(rmax))
+      , "SafeInt: product result cannot be represented using native types");
+
+    static constexpr intwide_t corners[] =
+    {
+      static_cast<intwide_t>(lmin) * static_cast<intwide_t>(rmin)
+    , static_cast<intwide_t>(lmin) * static_cast<intwide_t>(rmax)
+    , static_cast<intwide_t>(lmax) * static_cast<intwide_t>(rmin)
+    , static_cast<intwide_t>(lmax) * static_cast<intwide_t>(rmax)
+    };
+
+    static constexpr intwide_t newmin = std::min({corners[0], corners[1], corners[2], corners[3]});
+    static constexpr intwide_t newmax = std::max({corners[0], corners[1], corners[2], corners[3]});
+
+    using result_type = safe_signed<newmin, newmax>;
+    using value_type = typename result_type::value_type;
+
+    // the product is computed modulo 2^64 (2^128 for wide results), which is exact since it's known to be in range
+    static constexpr auto call(T lhs, U rhs) noexcept
+    {
+      return result_type{static_cast<value_type>(
+          static_cast<product_type<value_type>>(static_cast<typename T::value_type>(lhs))
+        * static_cast<product_type<value_type>>(static_cast<typename U::value_type>(rhs))
+        ), unchecked_construct};
+    }
+  };
+
+  template<typename T, typename U>
+  struct mul<T, U, false>
+  {
+    static constexpr auto lmin = static_cast<typename T::value_type>(std::numeric_limits<T>::min());
+    static constexpr auto lmax = static_cast<typename T::value_type>(std::numeric_limits<T>::max());
+
+    static constexpr auto rmin = static_cast<typename U::value_type>(std::numeric_limits<U>::min());
+    static constexpr auto rmax = static_cast<typename U::value_type>(std::numeric_limits<U>::max());
+
+    static_assert(mul_fits(static_cast<uintwide_t>(lmax), static_cast<uintwide_t>(rmax))
+      , "SafeInt: product result cannot be represented using native types");
+
+    static constexpr uintwide_t newmin = static_cast<uintwide_t>(lmin) * static_cast<uintwide_t>(rmin);
+    static constexpr uintwide_t newmax = static_cast<uintwide_t>(lmax) * static_cast<uintwide_t>(rmax);
+
+    using result_type = safe_unsigned<newmin, newmax>;
+    using value_type = typename result_type::value_type;
+
+    static constexpr auto call(T lhs, U rhs) noexcept
+    {
+      return result_type{static_cast<value_type>(
+          static_cast<product_type<value_type>>(static_cast<typename T::value_type>(lhs))
+        * static_cast<product_type<value_type>>(static_cast<typename U::value_type>(rhs))
+        ), unchecked_construct};
+    }
+  };
+}
+
+template
+<
+  typename T
+, typename U
+, typename = std::enable_if_t<(detail::is_safe_v<T> && detail::is_safe_v<U>)>
+>
+constexpr auto operator*(T lhs, U rhs) noexcept
+{
+  return detail::mul<T, U>::call(lhs, rhs);
+}
+
+// division helpers
+// quotients and remainders truncate towards zero, as for native types
+// the divisor range is split into its negative and positive part, zero is checked at runtime only if it's in range
+namespace detail
+{
+  template
+  <
+    typename T
+  , typename U
+  , bool = (integer_limits<typename T::value_type>::is_signed || integer_limits<typename U::value_type>::is_signed)
+  >
+  struct div;
+
+  template<typename T, typename U>
+  struct div<T, U, true>
+  {
+    static constexpr auto min = std::numeric_limits<intmax_t>::min();
+    static constexpr auto max = std::numeric_limits<intmax_t>::max();
+
+    static constexpr auto lmin = static_cast<typename T::value_type>(std::numeric_limits<T>::min());
+    static constexpr auto lmax = static_cast<typename T::value_type>(std::numeric_limits<T>::max());
+
+    static constexpr auto rmin = static_cast<typename U::value_type>(std::numeric_limits<U>::min());
+    static constexpr auto rmax = static_cast<typename U::value_type>(std::numeric_limits<U>::max());
+
+    static_assert(fits_intmax_v<T> && fits_intmax_v<U>
+      , "SafeInt: quotient result cannot be represented using native types");
+    static_assert((rmin != 0) || (rmax != 0), "SafeInt: division by zero");
+
+    static constexpr bool may_divide_by_zero = (rmin <= 0) && (rmax >= 0);
+    /// min / -1 is the only quotient that exceeds intmax_t, narrower dividends are divided in a wider type instead
+    static constexpr bool may_overflow = (static_cast<intmax_t>(lmin) == min) && (static_cast<intmax_t>(rmin) <= -1) && (static_cast<intmax_t>(rmax) >= -1);
+
+    static constexpr intmax_t quotient(intmax_t a, intmax_t d) noexcept
+    {
+      // min / -1 is rejected at runtime, so the largest quotient left is that of min + 1
+      return ((min == a) && (-1 == d)) ? max : (a / d);
+    }
+
+    /// the quotient is monotonic in both operands on either side of zero, so its bounds are found at the corners
+    static constexpr intmax_t bound(bool upper) noexcept
+    {
+      intmax_t const dividends[] = {static_cast<intmax_t>(lmin), static_cast<intmax_t>(lmax)};
+      intmax_t const divisors[] = {static_cast<intmax_t>(rmin), std::min(static_cast<intmax_t>(rmax), intmax_t{-1}), std::max(static_cast<intmax_t>(rmin), intmax_t{1}), static_cast<intmax_t>(rmax)};
+      bool const valid[] = {(rmin < 0), (rmin < 0), (rmax > 0), (rmax > 0)};
+
+      intmax_t res = upper ? min : max;
+      for(size_t i{}; i < 4U; ++i)
+      {
+        for(intmax_t a : dividends)
+        {
+          if(valid[i])
+          {
+            res = upper ? std::max(res, quotient(a, divisors[i])) : std::min(res, quotient(a, divisors[i]));
+          }
+        }
+      }
+      return res;
+    }
+
+    static constexpr intmax_t newmin = bound(false);
+    static constexpr intmax_t newmax = bound(true);
+
+    using result_type = safe_signed<newmin, newmax>;
+    using value_type = typename result_type::value_type;
+
+    /// holds both operands and the quotient
+    using compute_type = typename signed_type_from_range<std::min({static_cast<intmax_t>(lmin), static_cast<intmax_t>(rmin), newmin}), std::max({static_cast<intmax_t>(lmax), static_cast<intmax_t>(rmax), newmax})>::type;
+
+    static constexpr auto call(T lhs, U rhs) noexcept(!may_divide_by_zero && !may_overflow)
+    {
+      auto const a = static_cast<compute_type>(static_cast<typename T::value_type>(lhs));
+      // constant divisors are passed as such, so the compiler replaces the division with a multiplication and shifts
+      auto const b = (rmin == rmax) ? static_cast<compute_type>(rmin) : static_cast<compute_type>(static_cast<typename U::value_type>(rhs));
+      if constexpr(may_divide_by_zero)
+      {
+        if(0 == b)
+        {
+          detail::raise<std::domain_error>("SafeInt: division by zero.");
+        }
+      }
+      if constexpr(may_overflow)
+      {
+        if((min == a) && (-1 == b))
+        {
+          detail::raise<std::domain_error>("SafeInt: quotient cannot be represented.");
+        }
+      }
+      return result_type{static_cast<value_type>(a / b), unchecked_construct};
+    }
+  };
+
+  template<typename T, typename U>
+  struct div<T, U, false>
+  {
+    static constexpr auto lmin = static_cast<typename T::value_type>(std::numeric_limits<T>::min());
+    static constexpr auto lmax = static_cast<typename T::value_type>(std::numeric_limits<T>::max());
+
+    static constexpr auto rmin = static_cast<typename U::value_type>(std::numeric_limits<U>::min());
+    static constexpr auto rmax = static_cast<typename U::value_type>(std::numeric_limits<U>::max());
+
+    static_assert(fits_uintmax_v<T> && fits_uintmax_v<U>
+      , "SafeInt: quotient result cannot be represented using native types");
+    static_assert(0U != rmax, "SafeInt: division by zero");
+
+    static constexpr bool may_divide_by_zero = (0U == rmin);
+    static constexpr bool may_overflow = false;
+
+    static constexpr uintmax_t newmin = static_cast<uintmax_t>(lmin) / static_cast<uintmax_t>(rmax);
+    static constexpr uintmax_t newmax = static_cast<uintmax_t>(lmax) / std::max(static_cast<uintmax_t>(rmin), uintmax_t{1U});
+
+    using result_type = safe_unsigned<newmin, newmax>;
+    using value_type = typename result_type::value_type;
+
+    using compute_type = typename unsigned_type_from_range<0U, std::max(static_cast<uintmax_t>(lmax), static_cast<uintmax_t>(rmax))>::type;
+
+    static constexpr auto call(T lhs, U rhs) noexcept(!may_divide_by_zero)
+    {
+      auto const a = static_cast<compute_type>(static_cast<typename T::value_type>(lhs));
+      auto const b = (rmin == rmax) ? static_cast<compute_type>(rmin) : static_cast<compute_type>(static_cast<typename U::value_type>(rhs));
+      if constexpr(may_divide_by_zero)
+      {
+        if(0U == b)
+        {
+          detail::raise<std::domain_error>("SafeInt: division by zero.");
+        }
+      }
+      return result_type{static_cast<value_type>(a / b), unchecked_construct};
+    }
+  };
+
+  /// remainders take the sign of the dividend, are smaller than the largest divisor in magnitude
+  /// and no larger than the dividend in magnitude
+  template
+  <
+    typename T
+  , typename U
+  , bool = (integer_limits<typename T::value_type>::is_signed || integer_limits<typename U::value_type>::is_signed)
+  >
+  struct mod;
+
+  template<typename T, typename U>
+  struct mod<T, U, true>
+  {
+    static constexpr auto max = std::numeric_limits<intmax_t>::max();
+
+    static constexpr auto lmin = static_cast<typename T::value_type>(std::numeric_limits<T>::min());
+    static constexpr auto lmax = static_cast<typename T::value_type>(std::numeric_limits<T>::max());
+
+    static constexpr auto rmin = static_cast<typename U::value_type>(std::numeric_limits<U>::min());
+    static constexpr auto rmax = static_cast<typename U::value_type>(std::numeric_limits<U>::max());
+
+    static_assert(fits_intmax_v<T> && fits_intmax_v<U>
+      , "SafeInt: remainder result cannot be represented using native types");
+    static_assert((rmin != 0) || (rmax != 0), "SafeInt: division by zero");
+
+    /// holds both operands
+    using compute_type = typename signed_type_from_range<std::min(static_cast<intmax_t>(lmin), static_cast<intmax_t>(rmin)), std::max(static_cast<intmax_t>(lmax), static_cast<intmax_t>(rmax))>::type;
+
+    static constexpr bool may_divide_by_zero = (rmin <= 0) && (rmax >= 0);
+    /// the remainder of min / -1 is 0, but computing it overflows
+    static constexpr bool may_overflow = (static_cast<intmax_t>(lmin) == static_cast<intmax_t>(std::numeric_limits<compute_type>::min())) && (static_cast<intmax_t>(rmin) <= -1) && (static_cast<intmax_t>(rmax) >= -1);
+
+    // magnitudes are computed as unsigned values, since |min| exceeds intmax_t
+    static constexpr uintmax_t largest_divisor = std::max((rmin < 0) ? (uintmax_t{} - static_cast<uintmax_t>(rmin)) : uintmax_t{}, (rmax > 0) ? static_cast<uintmax_t>(rmax) : uintmax_t{});
+
+    static constexpr intmax_t newmin = (lmin < 0) ? (intmax_t{} - static_cast<intmax_t>(std::min(uintmax_t{} - static_cast<uintmax_t>(lmin), largest_divisor - 1U))) : intmax_t{};
+    static constexpr intmax_t newmax = (lmax > 0) ? static_cast<intmax_t>(std::min(static_cast<uintmax_t>(lmax), largest_divisor - 1U)) : intmax_t{};
+
+    using result_type = safe_signed<newmin, newmax>;
+    using value_type = typename result_type::value_type;
+
+    static constexpr auto call(T lhs, U rhs) noexcept(!may_divide_by_zero)
+    {
+      auto const a = static_cast<compute_type>(static_cast<typename T::value_type>(lhs));
+      auto const b = (rmin == rmax) ? static_cast<compute_type>(rmin) : static_cast<compute_type>(static_cast<typename U::value_type>(rhs));
+      if constexpr(may_divide_by_zero)
+      {
+        if(0 == b)
+        {
+          detail::raise<std::domain_error>("SafeInt: division by zero.");
+        }
+      }
+      if constexpr(may_overflow)
+      {
+        if(-1 == b)
+        {
+          return result_type{value_type{}, unchecked_construct};
+        }
+      }
+      return result_type{static_cast<value_type>(a % b), unchecked_construct};
+    }
+  };
+
+  template<typename T, typename U>
+  struct mod<T, U, false>
+  {
+    static constexpr auto lmin = static_cast<typename T::value_type>(std::numeric_limits<T>::min());
+    static constexpr auto lmax = static_cast<typename T::value_type>(std::numeric_limits<T>::max());
+
+    static constexpr auto rmin = static_cast<typename U::value_type>(std::numeric_limits<U>::min());
+    static constexpr auto rmax = static_cast<typename U::value_type>(std::numeric_limits<U>::max());
+
+    static_assert(fits_uintmax_v<T> && fits_uintmax_v<U>
+      , "SafeInt: remainder result cannot be represented using native types");
+    static_assert(0U != rmax, "SafeInt: division by zero");
+
+    static constexpr bool may_divide_by_zero = (0U == rmin);
+
+    static constexpr uintmax_t newmin = 0U;
+    static constexpr uintmax_t newmax = std::min(static_cast<uintmax_t>(lmax), static_cast<uintmax_t>(rmax) - 1U);
+
+    using result_type = safe_unsigned<newmin, newmax>;
+    using value_type = typename result_type::value_type;
+
+    using compute_type = typename unsigned_type_from_range<0U, std::max(static_cast<uintmax_t>(lmax), static_cast<uintmax_t>(rmax))>::type;
+
+    static constexpr auto call(T lhs, U rhs) noexcept(!may_divide_by_zero)
+    {
+      auto const a = static_cast<compute_type>(static_cast<typename T::value_type>(lhs));
+      auto const b = (rmin == rmax) ? static_cast<compute_type>(rmin) : static_cast<compute_type>(static_cast<typename U::value_type>(rhs));
+      if constexpr(may_divide_by_zero)
+      {
+        if(0U == b)
+        {
+          detail::raise<std::domain_error>("SafeInt: division by zero.");
+        }
+      }
+      return result_type{static_cast<value_type>(a % b), unchecked_construct};
+    }
+  };
+}
+
+template
+<
+  typename T
+, typename U
+, typename = std::enable_if_t<(detail::is_safe_v<T> && detail::is_safe_v<U>)>
+>
+constexpr auto operator/(T lhs, U rhs) noexcept(noexcept(detail::div<T, U>::call(lhs, rhs)))
+{
+  return detail::div<T, U>::call(lhs, rhs);
+}
+
+template
+<
+  typename T
+, typename U
+, typename = std::enable_if_t<(detail::is_safe_v<T> && detail::is_safe_v<U>)>
+>
+constexpr auto operator%(T lhs, U rhs) noexcept(noexcept(detail::mod<T, U>::call(lhs, rhs)))
+{
+  return detail::mod<T, U>::call(lhs, rhs);
+}
+
+// bitwise helpers
+// operands are treated as infinite precision two's complement numbers, so results don't depend on the storage types
+namespace detail
+{
+  enum class bit_op
+  {
+    bit_and
+  , bit_or
+  , bit_xor
+  };
+
+  /// smallest w such that [min, max] is contained in [-2^w, 2^w - 1]
+  constexpr size_t magnitude_bits(intmax_t min, intmax_t max) noexcept
+  {
+    return std::max(bit_width(static_cast<uint64_t>((min < 0) ? ~min : min)), bit_width(static_cast<uint64_t>((max < 0) ? ~max : max)));
+  }
+
+  template
+  <
+    typename T
+  , typename U
+  , bit_op op
+  , bool = (integer_limits<typename T::value_type>::is_signed || integer_limits<typename U::value_type>::is_signed)
+  >
+  struct bitwise;
+
+  template<typename T, typename U, bit_op op>
+  struct bitwise<T, U, op, true>
+  {
+    static constexpr auto min = std::numeric_limits<intmax_t>::min();
+    static constexpr auto max = std::numeric_limits<intmax_t>::max();
+
+    static constexpr auto lmin = static_cast<typename T::value_type>(std::numeric_limits<T>::min());
+    static constexpr auto lmax = static_cast<typename T::value_type>(std::numeric_limits<T>::max());
+
+    static constexpr auto rmin = static_cast<typename U::value_type>(std::numeric_limits<U>::min());
+    static constexpr auto rmax = static_cast<typename U::value_type>(std::numeric_limits<U>::max());
+
+    static_assert(fits_intmax_v<T> && fits_intmax_v<U>
+      , "SafeInt: bitwise result cannot be represented using native types");
+
+    // both operands, and therefore the result, are in [lo, hi]
+    static constexpr size_t bits = std::max(magnitude_bits(static_cast<intmax_t>(lmin), static_cast<intmax_t>(lmax)), magnitude_bits(static_cast<intmax_t>(rmin), static_cast<intmax_t>(rmax)));
+    static constexpr intmax_t lo = (bits < 63U) ? -(intmax_t{1} << bits) : min;
+    static constexpr intmax_t hi = (bits < 63U) ? ((intmax_t{1} << bits) - 1) : max;
+
+    static constexpr bool lhs_positive = (static_cast<intmax_t>(lmin) >= 0);
+    static constexpr bool rhs_positive = (static_cast<intmax_t>(rmin) >= 0);
+    static constexpr bool lhs_negative = (static_cast<intmax_t>(lmax) < 0);
+    static constexpr bool rhs_negative = (static_cast<intmax_t>(rmax) < 0);
+
+    // a & b doesn't exceed a if either is non-negative and doesn't exceed either if both are negative
+    // a | b isn't below a if either is negative and isn't below either if both are non-negative
+    // a ^ b is non-negative if both have the same sign and negative otherwise
+    static constexpr intmax_t newmin =
+        (bit_op::bit_and == op) ? ((lhs_positive || rhs_positive) ? 0 : lo)
+      : (bit_op::bit_or == op) ? (((lhs_positive && rhs_positive) || (lhs_negative && rhs_negative)) ? std::max(static_cast<intmax_t>(lmin), static_cast<intmax_t>(rmin)) : std::min(static_cast<intmax_t>(lmin), static_cast<intmax_t>(rmin)))
+      : (((lhs_positive && rhs_positive) || (lhs_negative && rhs_negative)) ? 0 : lo);
+    static constexpr intmax_t newmax =
+        (bit_op::bit_and == op) ? (((lhs_positive && rhs_positive) || (lhs_negative && rhs_negative)) ? std::min(static_cast<intmax_t>(lmax), static_cast<intmax_t>(rmax)) : lhs_positive ? static_cast<intmax_t>(lmax) : rhs_positive ? static_cast<intmax_t>(rmax) : std::max(static_cast<intmax_t>(lmax), static_cast<intmax_t>(rmax)))
+      : (bit_op::bit_or == op) ? ((lhs_negative || rhs_negative) ? -1 : hi)
+      : (((lhs_positive && rhs_negative) || (lhs_negative && rhs_positive)) ? -1 : hi);
+
+    using result_type = safe_signed<newmin, newmax>;
+    using value_type = typename result_type::value_type;
+
+    static constexpr auto call(T lhs, U rhs) noexcept
+    {
+      auto const a = static_cast<intmax_t>(static_cast<typename T::value_type>(lhs));
+      auto const b = static_cast<intmax_t>(static_cast<typename U::value_type>(rhs));
+      return result_type{static_cast<value_type>((bit_op::bit_and == op) ? (a & b) : (bit_op::bit_or == op) ? (a | b) : (a ^ b)), unchecked_construct};
+    }
+  };
+
+  template<typename T, typename U, bit_op op>
+  struct bitwise<T, U, op, false>
+  {
+    static constexpr auto lmin = static_cast<typename T::value_type>(std::numeric_limits<T>::min());
+    static constexpr auto lmax = static_cast<typename T::value_type>(std::numeric_limits<T>::max());
+
+    static constexpr auto rmin = static_cast<typename U::value_type>(std::numeric_limits<U>::min());
+    static constexpr auto rmax = static_cast<typename U::value_type>(std::numeric_limits<U>::max());
+
+    static_assert(fits_uintmax_v<T> && fits_uintmax_v<U>
+      , "SafeInt: bitwise result cannot be represented using native types");
+
+    /// all bits that may be set in either operand
+    static constexpr uintmax_t hi = low_mask(bit_width(std::max(static_cast<uint64_t>(lmax), static_cast<uint64_t>(rmax))));
+
+    static constexpr uintmax_t newmin = (bit_op::bit_or == op) ? std::max(static_cast<uintmax_t>(lmin), static_cast<uintmax_t>(rmin)) : 0U;
+    static constexpr uintmax_t newmax = (bit_op::bit_and == op) ? std::min(static_cast<uintmax_t>(lmax), static_cast<uintmax_t>(rmax)) : hi;
+
+    using result_type = safe_unsigned<newmin, newmax>;
+    using value_type = typename result_type::value_type;
+
+    static constexpr auto call(T lhs, U rhs) noexcept
+    {
+      auto const a = static_cast<uintmax_t>(static_cast<typename T::value_type>(lhs));
+      auto const b = static_cast<uintmax_t>(static_cast<typename U::value_type>(rhs));
+      return result_type{static_cast<value_type>((bit_op::bit_and == op) ? (a & b) : (bit_op::bit_or == op) ? (a | b) : (a ^ b)), unchecked_construct};
+    }
+  };
+
+  /// ~a == -a - 1, for unsigned types as well
+  template<typename T>
+  struct complement
+  {
+    static constexpr auto min = std::numeric_limits<intmax_t>::min();
+    static constexpr auto max = std::numeric_limits<intmax_t>::max();
+
+    static constexpr auto lmin = static_cast<typename T::value_type>(std::numeric_limits<T>::min());
+    static constexpr auto lmax = static_cast<typename T::value_type>(std::numeric_limits<T>::max());
+
+    static_assert(fits_intmax_v<T>, "SafeInt: complement result cannot be represented using native types");
+
+    static constexpr intmax_t newmin = ~static_cast<intmax_t>(lmax);
+    static constexpr intmax_t newmax = ~static_cast<intmax_t>(lmin);
+
+    using result_type = safe_signed<newmin, newmax>;
+    using value_type = typename result_type::value_type;
+
+    static constexpr auto call(T v) noexcept
+    {
+      return result_type{static_cast<value_type>(~static_cast<intmax_t>(static_cast<typename T::value_type>(v))), unchecked_construct};
+    }
+  };
+
+  /// a << s multiplies by 2^s, a >> s divides by 2^s rounding towards negative infinity
+  /// constant shift amounts (safe<T, c, c>) are passed as such
+  template<typename T, typename S, bool left, bool = integer_limits<typename T::value_type>::is_signed>
+  struct shift;
+
+  template<typename S>
+  struct shift_amount
+  {
+    static constexpr auto smin = static_cast<typename S::value_type>(std::numeric_limits<S>::min());
+    static constexpr auto smax = static_cast<typename S::value_type>(std::numeric_limits<S>::max());
+
+    static_assert((static_cast<intmax_t>(smin) >= 0) && (static_cast<uintmax_t>(smax) < std::numeric_limits<uintmax_t>::digits)
+      , "SafeInt: shift amount must be less than the width of native types");
+
+    static constexpr auto lo = static_cast<size_t>(smin);
+    static constexpr auto hi = static_cast<size_t>(smax);
+
+    static constexpr size_t get(S s) noexcept
+    {
+      return (lo == hi) ? lo : static_cast<size_t>(static_cast<typename S::value_type>(s));
+    }
+  };
+
+  template<typename T, typename S>
+  struct shift<T, S, true, true>
+  {
+    static_assert(fits_intmax_v<T>, "SafeInt: shifted result cannot be represented using native types");
+
+    static constexpr auto min = std::numeric_limits<intmax_t>::min();
+    static constexpr auto max = std::numeric_limits<intmax_t>::max();
+
+    using amount = shift_amount<S>;
+    static constexpr auto lmin = static_cast<intmax_t>(static_cast<typename T::value_type>(std::numeric_limits<T>::min()));
+    static constexpr auto lmax = static_cast<intmax_t>(static_cast<typename T::value_type>(std::numeric_limits<T>::max()));
+
+    static_assert((lmin >= (min >> amount::hi)) && (lmax <= (max >> amount::hi))
+      , "SafeInt: shifted result cannot be represented using native types");
+
+    static constexpr intmax_t scale(intmax_t v, size_t s) noexcept
+    {
+      return static_cast<intmax_t>(static_cast<uintmax_t>(v) << s);
+    }
+
+    static constexpr intmax_t newmin = scale(lmin, (lmin < 0) ? amount::hi : amount::lo);
+    static constexpr intmax_t newmax = scale(lmax, (lmax < 0) ? amount::lo : amount::hi);
+
+    using result_type = safe_signed<newmin, newmax>;
+    using value_type = typename result_type::value_type;
+
+    static constexpr auto call(T lhs, S rhs) noexcept
+    {
+      return result_type{static_cast<value_type>(scale(static_cast<typename T::value_type>(lhs), amount::get(rhs))), unchecked_construct};
+    }
+  };
+
+  template<typename T, typename S>
+  struct shift<T, S, true, false>
+  {
+    static_assert(fits_uintmax_v<T>, "SafeInt: shifted result cannot be represented using native types");
+
+    using amount = shift_amount<S>;
+    static constexpr auto lmin = static_cast<uintmax_t>(static_cast<typename T::value_type>(std::numeric_limits<T>::min()));
+    static constexpr auto lmax = static_cast<uintmax_t>(static_cast<typename T::value_type>(std::numeric_limits<T>::max()));
+
+    static_assert(lmax <= (std::numeric_limits<uintmax_t>::max() >> amount::hi)
+      , "SafeInt: shifted result cannot be represented using native types");
+
+    static constexpr uintmax_t newmin = lmin << amount::lo;
+    static constexpr uintmax_t newmax = lmax << amount::hi;
+
+    using result_type = safe_unsigned<newmin, newmax>;
+    using value_type = typename result_type::value_type;
+
+    static constexpr auto call(T lhs, S rhs) noexcept
+    {
+      return result_type{static_cast<value_type>(static_cast<uintmax_t>(static_cast<typename T::value_type>(lhs)) << amount::get(rhs)), unchecked_construct};
+    }
+  };
+
+  template<typename T, typename S>
+  struct shift<T, S, false, true>
+  {
+    static_assert(fits_intmax_v<T>, "SafeInt: shifted result cannot be represented using native types");
+
+    using amount = shift_amount<S>;
+    static constexpr auto lmin = static_cast<intmax_t>(static_cast<typename T::value_type>(std::numeric_limits<T>::min()));
+    static constexpr auto lmax = static_cast<intmax_t>(static_cast<typename T::value_type>(std::numeric_limits<T>::max()));
+
+    // right shifts of negative values are arithmetic on every supported compiler
+    static constexpr intmax_t newmin = lmin >> ((lmin < 0) ? amount::lo : amount::hi);
+    static constexpr intmax_t newmax = lmax >> ((lmax < 0) ? amount::hi : amount::lo);
+
+    using result_type = safe_signed<newmin, newmax>;
+    using value_type = typename result_type::value_type;
+
+    static constexpr auto call(T lhs, S rhs) noexcept
+    {
+      return result_type{static_cast<value_type>(static_cast<intmax_t>(static_cast<typename T::value_type>(lhs)) >> amount::get(rhs)), unchecked_construct};
+    }
+  };
+
+  template<typename T, typename S>
+  struct shift<T, S, false, false>
+  {
+    static_assert(fits_uintmax_v<T>, "SafeInt: shifted result cannot be represented using native types");
+
+    using amount = shift_amount<S>;
+    static constexpr auto lmin = static_cast<uintmax_t>(static_cast<typename T::value_type>(std::numeric_limits<T>::min()));
+    static constexpr auto lmax = static_cast<uintmax_t>(static_cast<typename T::value_type>(std::numeric_limits<T>::max()));
+
+    static constexpr uintmax_t newmin = lmin >> amount::hi;
+    static constexpr uintmax_t newmax = lmax >> amount::lo;
+
+    using result_type = safe_unsigned<newmin, newmax>;
+    using value_type = typename result_type::value_type;
+
+    static constexpr auto call(T lhs, S rhs) noexcept
+    {
+      return result_type{static_cast<value_type>(static_cast<uintmax_t>(static_cast<typename T::value_type>(lhs)) >> amount::get(rhs)), unchecked_construct};
+    }
+  };
+}
+
+template
+<
+  typename T
+, typename U
+, typename = std::enable_if_t<(detail::is_safe_v<T> && detail::is_safe_v<U>)>
+>
+constexpr auto operator&(T lhs, U rhs) noexcept
+{
+  return detail::bitwise<T, U, detail::bit_op::bit_and>::call(lhs, rhs);
+}
+
+template
+<
+  typename T
+, typename U
+, typename = std::enable_if_t<(detail::is_safe_v<T> && detail::is_safe_v<U>)>
+>
+constexpr auto operator|(T lhs, U rhs) noexcept
+{
+  return detail::bitwise<T, U, detail::bit_op::bit_or>::call(lhs, rhs);
+}
+
+template
+<
+  typename T
+, typename U
+, typename = std::enable_if_t<(detail::is_safe_v<T> && detail::is_safe_v<U>)>
+>
+constexpr auto operator^(T lhs, U rhs) noexcept
+{
+  return detail::bitwise<T, U, detail::bit_op::bit_xor>::call(lhs, rhs);
+}
+
+template<typename T, typename = std::enable_if_t<detail::is_safe_v<T>>>
+constexpr auto operator~(T v) noexcept
+{
+  return detail::complement<T>::call(v);
+}
+
+template
+<
+  typename T
+, typename S
+, typename = std::enable_if_t<(detail::is_safe_v<T> && detail::is_safe_v<S>)>
+>
+constexpr auto operator<<(T lhs, S rhs) noexcept
+{
+  return detail::shift<T, S, true>::call(lhs, rhs);
+}
+
+template
+<
+  typename T
+, typename S
+, typename = std::enable_if_t<(detail::is_safe_v<T> && detail::is_safe_v<S>)>
+>
+constexpr auto operator>>(T lhs, S rhs) noexcept
+{
+  return detail::shift<T, S, false>::call(lhs, rhs);
+}
+
+template<typename T, T min, T max, typename P>
+struct is_packable<safe<T, min, max, P>> : std::true_type
 {
 };
 
 namespace detail
 {
-  // @@@FIXME: signed overflow when max-min >= intmax_t max
-  template<typename T, T min, T max>
+  // codes are computed as unsigned differences from min, which are well defined for every range of T
+  template<typename T, T min, T max, typename P>
   struct signed_packable_traits
   {
-    static constexpr uintmax_t packed_size = (min != max) ? (1U + log2_v<(static_cast<intmax_t>(max) - static_cast<intmax_t>(min))>) : 0U;
-    using value_type = safe<T, min, max>;
+    static constexpr uintmax_t packed_size = (min != max) ? (1U + log2_v<(static_cast<uintmax_t>(max) - static_cast<uintmax_t>(min))>) : 0U;
+    using value_type = safe<T, min, max, P>;
     using packed_type = bitstream<packed_size>;
 
-    static constexpr packed_type pack(value_type const &v)
+    /// largest code produced by pack
+    static constexpr uint64_t max_code = static_cast<uint64_t>(static_cast<uintmax_t>(max) - static_cast<uintmax_t>(min));
+
+    /// pack never produces codes past max - min, if there are any the all ones code marks an empty optional
+    static constexpr bool has_niche = (max_code < detail::low_mask(packed_size));
+
+    static constexpr packed_type niche() noexcept
+    {
+      return packed_type{detail::low_mask(packed_size)};
+    }
+
+    static constexpr bool is_niche(packed_type const &v) noexcept
+    {
+      return v.extract(0U, packed_size) == detail::low_mask(packed_size);
+    }
+
+    static constexpr packed_type pack(value_type const &v) noexcept
+    {
+      return packed_type{static_cast<uint64_t>(static_cast<uintmax_t>(static_cast<T>(v)) - static_cast<uintmax_t>(min))};
+    }
+
+    static constexpr value_type unpack(packed_type const &v) noexcept
+    {
+      return value_type{static_cast<T>(static_cast<uintmax_t>(min) + v.extract(0U, packed_size)), unchecked_construct};
+    }
+
+    static void pack_into(std::byte *base, size_t bit_offset, value_type const &v) noexcept
     {
-      return{static_cast<uintmax_t>(static_cast<intmax_t>(static_cast<T>(v)) - static_cast<intmax_t>(min))};
+      detail::store_bits<packed_size>(base, bit_offset, static_cast<uint64_t>(static_cast<uintmax_t>(static_cast<T>(v)) - static_cast<uintmax_t>(min)));
     }
 
-    static constexpr value_type unpack(packed_type const &v)
+    static value_type unpack_from(std::byte const *base, size_t bit_offset) noexcept
     {
-      return value_type{static_cast<T>(static_cast<intmax_t>(v.to_ullong()) + static_cast<intmax_t>(min)), unchecked_construct};
+      return value_type{static_cast<T>(static_cast<uintmax_t>(min) + detail::load_bits<packed_size>(base, bit_offset)), unchecked_construct};
     }
   };
 
-  template<typename T, T min, T max>
+  template<typename T, T min, T max, typename P>
   struct unsigned_packable_traits
   {
     static constexpr uintmax_t packed_size = (min != max) ? (1U + log2_v<(max - min)>) : 0U;
-    using value_type = safe<T, min, max>;
+    using value_type = safe<T, min, max, P>;
     using packed_type = bitstream<packed_size>;
 
-    static constexpr packed_type pack(value_type const &v)
+    /// largest code produced by pack
+    static constexpr uint64_t max_code = static_cast<uint64_t>(static_cast<uintmax_t>(max - min));
+
+    /// pack never produces codes past max - min, if there are any the all ones code marks an empty optional
+    static constexpr bool has_niche = (max_code < detail::low_mask(packed_size));
+
+    static constexpr packed_type niche() noexcept
+    {
+      return packed_type{detail::low_mask(packed_size)};
+    }
+
+    static constexpr bool is_niche(packed_type const &v) noexcept
+    {
+      return v.extract(0U, packed_size) == detail::low_mask(packed_size);
+    }
+
+    static constexpr packed_type pack(value_type const &v) noexcept
     {
-      return{static_cast<T>(v) - min};
+      return packed_type{static_cast<uint64_t>(static_cast<T>(v) - min)};
     }
 
-    static constexpr value_type unpack(packed_type const &v)
+    static constexpr value_type unpack(packed_type const &v) noexcept
     {
-      return value_type{static_cast<T>(v.to_ullong()) + static_cast<T>(min), unchecked_construct};
+      return value_type{static_cast<T>(v.extract(0U, packed_size) + min), unchecked_construct};
+    }
+
+    static void pack_into(std::byte *base, size_t bit_offset, value_type const &v) noexcept
+    {
+      detail::store_bits<packed_size>(base, bit_offset, static_cast<uint64_t>(static_cast<T>(v) - min));
+    }
+
+    static value_type unpack_from(std::byte const *base, size_t bit_offset) noexcept
+    {
+      return value_type{static_cast<T>(detail::load_bits<packed_size>(base, bit_offset) + min), unchecked_construct};
     }
   };
 }
 
-template<typename T, T min, T max>
-struct packable_traits<safe<T, min, max>>
-  : std::conditional_t<std::is_signed_v<T>
-  , detail::signed_packable_traits<T, min, max>
-  , detail::unsigned_packable_traits<T, min, max>>
+#ifdef RDK_HAS_INT128
+namespace detail
+{
+  /// 128 bit storage; codes are unsigned 128 bit differences from min and take up to two words
+  template<typename T, T min, T max, typename P>
+  struct wide_packable_traits
+  {
+    static constexpr uint128_t max_difference = static_cast<uint128_t>(max) - static_cast<uint128_t>(min);
+    static constexpr uintmax_t packed_size = bit_width(static_cast<uint64_t>(max_difference >> word_bits)) + ((0U != (max_difference >> word_bits)) ? word_bits : bit_width(static_cast<uint64_t>(max_difference)));
+    using value_type = safe<T, min, max, P>;
+    using packed_type = bitstream<packed_size>;
+
+    static constexpr packed_type pack(value_type const &v) noexcept
+    {
+      auto const code = static_cast<uint128_t>(static_cast<T>(v)) - static_cast<uint128_t>(min);
+      packed_type res{static_cast<uint64_t>(code)};
+      if constexpr(packed_size > word_bits)
+      {
+        res.insert(word_bits, packed_size - word_bits, static_cast<uint64_t>(code >> word_bits));
+      }
+      return res;
+    }
+
+    static constexpr value_type unpack(packed_type const &v) noexcept
+    {
+      auto code = static_cast<uint128_t>(v.extract(0U, std::min<size_t>(packed_size, word_bits)));
+      if constexpr(packed_size > word_bits)
+      {
+        code |= static_cast<uint128_t>(v.extract(word_bits, packed_size - word_bits)) << word_bits;
+      }
+      return value_type{static_cast<T>(static_cast<uint128_t>(min) + code), unchecked_construct};
+    }
+
+    static void pack_into(std::byte *base, size_t bit_offset, value_type const &v) noexcept
+    {
+      store_bitstream(base, bit_offset, pack(v));
+    }
+
+    static value_type unpack_from(std::byte const *base, size_t bit_offset) noexcept
+    {
+      return unpack(load_bitstream<packed_size>(base, bit_offset));
+    }
+  };
+} // namespace detail
+#endif
+
+template<typename T, T min, T max, typename P>
+struct packable_traits<safe<T, min, max, P>>
+  : std::conditional_t<(sizeof(T) > sizeof(uint64_t))
+#ifdef RDK_HAS_INT128
+  , detail::wide_packable_traits<T, min, max, P>
+#else
+  , void
+#endif
+  , std::conditional_t<std::is_signed_v<T>
+    , detail::signed_packable_traits<T, min, max, P>
+    , detail::unsigned_packable_traits<T, min, max, P>>>
 {
 };
 
@@ -556,11 +1687,11 @@ struct packable_traits<safe<T, min, max>>
 namespace std
 {
 
-template<typename T, T minV, T maxV>
-struct numeric_limits<::rdk::safe<T, minV, maxV>>
-  : public std::numeric_limits<T>
+template<typename T, T minV, T maxV, typename P>
+struct numeric_limits<::rdk::safe<T, minV, maxV, P>>
+  : public ::rdk::detail::integer_limits<T>
 {
-  using value_type = ::rdk::safe<T, minV, maxV>;
+  using value_type = ::rdk::safe<T, minV, maxV, P>;
 
   constexpr static bool traps = true;
   constexpr static bool is_bounded = true;
@@ -0,0 +1,343 @@
+#pragma once
+#ifndef RDK_3116E7E3FC7A441BA3649E4EF2B269A5
+#define RDK_3116E7E3FC7A441BA3649E4EF2B269A5
+
+#include "cpu_features.hpp"
+#include "packer.hpp"
+#include "safe_int.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace rdk
+{
+
+/// view of n contiguous elements
+template<typename T>
+class span
+{
+public:
+  using element_type = T;
+  using value_type = std::remove_cv_t<T>;
+  using size_type = size_t;
+  using iterator = T *;
+
+  constexpr span() noexcept = default;
+
+  constexpr span(T *data, size_t size) noexcept
+    : ptr(data)
+    , count(size)
+  {
+  }
+
+  template<size_t N>
+  constexpr span(T (&array)[N]) noexcept
+    : ptr(array)
+    , count(N)
+  {
+  }
+
+  /// contiguous containers, e.g. std::vector or std::array
+  template
+  <
+    typename C
+  , typename = std::enable_if_t<std::is_convertible_v<decltype(std::declval<C &>().data()), T *> && !std::is_array_v<C>>
+  , typename = decltype(std::declval<C &>().size())
+  >
+  constexpr span(C &container) noexcept
+    : ptr(container.data())
+    , count(container.size())
+  {
+  }
+
+  template<typename U, typename = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+  constexpr span(span<U> const &other) noexcept
+    : ptr(other.data())
+    , count(other.size())
+  {
+  }
+
+  constexpr T *data() const noexcept
+  {
+    return ptr;
+  }
+
+  constexpr size_t size() const noexcept
+  {
+    return count;
+  }
+
+  constexpr bool empty() const noexcept
+  {
+    return (0U == count);
+  }
+
+  constexpr T &operator[](size_t i) const noexcept
+  {
+    assert(i < count);
+    return ptr[i];
+  }
+
+  constexpr iterator begin() const noexcept
+  {
+    return ptr;
+  }
+
+  constexpr iterator end() const noexcept
+  {
+    return ptr + count;
+  }
+
+  constexpr span subspan(size_t offset, size_t n) const noexcept
+  {
+    assert((offset + n) <= count);
+    return span{ptr + offset, n};
+  }
+
+private:
+  T *ptr{};
+  size_t count{};
+};
+
+/// either a value or the error that prevented computing it
+template<typename T, typename E>
+class expected
+{
+public:
+  constexpr expected(T value) noexcept(std::is_nothrow_move_constructible_v<T>)
+    : v(std::in_place_index<0U>, std::move(value))
+  {
+  }
+
+  constexpr expected(E error) noexcept(std::is_nothrow_move_constructible_v<E>)
+    : v(std::in_place_index<1U>, std::move(error))
+  {
+  }
+
+  constexpr bool has_value() const noexcept
+  {
+    return (0U == v.index());
+  }
+
+  constexpr explicit operator bool() const noexcept
+  {
+    return has_value();
+  }
+
+  /// throws std::logic_error if there's no value
+  constexpr T const &value() const
+  {
+    if(!has_value())
+    {
+      detail::raise<std::logic_error>("expected: no value.");
+    }
+    return *std::get_if<0U>(&v);
+  }
+
+  constexpr T const &operator*() const noexcept
+  {
+    assert(has_value());
+    return *std::get_if<0U>(&v);
+  }
+
+  constexpr T const *operator->() const noexcept
+  {
+    assert(has_value());
+    return std::get_if<0U>(&v);
+  }
+
+  constexpr E const &error() const noexcept
+  {
+    assert(!has_value());
+    return *std::get_if<1U>(&v);
+  }
+
+private:
+  std::variant<T, E> v;
+};
+
+/// error of validate, the index of the first element out of range
+struct first_bad_index
+{
+  size_t index;
+};
+
+// validation kernels
+// vector kernels return how many leading elements they found in range, stopping at the first vector
+// containing an element out of range; the scalar kernel finds the first bad element from there
+namespace detail
+{
+  template<typename S>
+  struct validate_element
+  {
+    static_assert(is_safe_v<S>, "validate: elements must be safe integers");
+    static_assert(std::is_trivially_copyable_v<S> && std::is_standard_layout_v<S> && (sizeof(S) == sizeof(typename S::value_type)) && (alignof(S) == alignof(typename S::value_type))
+      , "validate: safe integers must be layout compatible with their value type");
+
+    using native_type = typename S::value_type;
+    static constexpr auto min = static_cast<native_type>(std::numeric_limits<S>::min());
+    static constexpr auto max = static_cast<native_type>(std::numeric_limits<S>::max());
+    /// every native value is in range
+    static constexpr bool trivial = (integer_limits<native_type>::min() == min) && (integer_limits<native_type>::max() == max);
+  };
+
+  /// index of the first element out of range, or n
+  /// blocks are checked branch free, so the check vectorizes, and only a bad block is searched element by element
+  template<typename S>
+  size_t validate_scalar(typename S::value_type const *in, size_t n) noexcept
+  {
+    using element = validate_element<S>;
+    constexpr size_t block_size = 64U;
+    size_t i{};
+    for(; (i + block_size) <= n; i += block_size)
+    {
+      bool bad = false;
+      for(size_t j{}; j < block_size; ++j)
+      {
+        bad |= ((in[i + j] < element::min) | (in[i + j] > element::max));
+      }
+      if(bad)
+      {
+        break;
+      }
+    }
+    for(; i < n; ++i)
+    {
+      if((in[i] < element::min) || (in[i] > element::max))
+      {
+        break;
+      }
+    }
+    return i;
+  }
+
+#ifdef RDK_X86_64
+  template<typename T>
+  RDK_TARGET("avx2") __m256i broadcast_avx2(T v) noexcept
+  {
+    if constexpr(8U == sizeof(T))
+    {
+      return _mm256_set1_epi64x(static_cast<long long>(v));
+    }
+    else if constexpr(4U == sizeof(T))
+    {
+      return _mm256_set1_epi32(static_cast<int>(v));
+    }
+    else if constexpr(2U == sizeof(T))
+    {
+      return _mm256_set1_epi16(static_cast<short>(v));
+    }
+    else
+    {
+      return _mm256_set1_epi8(static_cast<char>(v));
+    }
+  }
+
+  /// lane wise a > b for signed lanes of sizeof(T) bytes
+  template<typename T>
+  RDK_TARGET("avx2") __m256i greater_avx2(__m256i a, __m256i b) noexcept
+  {
+    if constexpr(8U == sizeof(T))
+    {
+      return _mm256_cmpgt_epi64(a, b);
+    }
+    else if constexpr(4U == sizeof(T))
+    {
+      return _mm256_cmpgt_epi32(a, b);
+    }
+    else if constexpr(2U == sizeof(T))
+    {
+      return _mm256_cmpgt_epi16(a, b);
+    }
+    else
+    {
+      return _mm256_cmpgt_epi8(a, b);
+    }
+  }
+
+  /// lanes loaded from in which are outside of [lo, hi] once flipped
+  template<typename T>
+  RDK_TARGET("avx2") __m256i out_of_range_avx2(T const *in, __m256i flip, __m256i lo, __m256i hi) noexcept
+  {
+    __m256i const v = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<__m256i const *>(in)), flip);
+    return _mm256_or_si256(greater_avx2<T>(lo, v), greater_avx2<T>(v, hi));
+  }
+
+  /// 32 bytes per compare; unsigned values are biased by their sign bit, so signed compares order them correctly
+  template<typename S>
+  RDK_TARGET("avx2") size_t validate_avx2(typename S::value_type const *in, size_t n) noexcept
+  {
+    using element = validate_element<S>;
+    using native_type = typename element::native_type;
+    using signed_type = std::make_signed_t<native_type>;
+    constexpr size_t lanes = 32U / sizeof(native_type);
+    constexpr auto bias = std::is_signed_v<native_type> ? native_type{} : static_cast<native_type>(std::numeric_limits<signed_type>::min());
+
+    __m256i const flip = broadcast_avx2(bias);
+    __m256i const lo = broadcast_avx2(static_cast<native_type>(element::min ^ bias));
+    __m256i const hi = broadcast_avx2(static_cast<native_type>(element::max ^ bias));
+
+    size_t i{};
+    for(; (i + (4U * lanes)) <= n; i += 4U * lanes)
+    {
+      __m256i const bad = _mm256_or_si256(
+          _mm256_or_si256(out_of_range_avx2(in + i, flip, lo, hi), out_of_range_avx2(in + (i + lanes), flip, lo, hi))
+        , _mm256_or_si256(out_of_range_avx2(in + (i + (2U * lanes)), flip, lo, hi), out_of_range_avx2(in + (i + (3U * lanes)), flip, lo, hi)));
+      if(!_mm256_testz_si256(bad, bad))
+      {
+        break;
+      }
+    }
+    for(; (i + lanes) <= n; i += lanes)
+    {
+      __m256i const bad = out_of_range_avx2(in + i, flip, lo, hi);
+      if(!_mm256_testz_si256(bad, bad))
+      {
+        break;
+      }
+    }
+    return i;
+  }
+#endif
+} // namespace detail
+
+/// checks that all values are in the range of S and, if they are, views them as S without copying
+/// otherwise yields the index of the first value out of range
+/// on x86-64 cpus with AVX2 the values are checked 32 bytes per compare, the kernel is selected at runtime
+template<typename S>
+expected<span<S const>, first_bad_index> validate(span<typename S::value_type const> in) noexcept
+{
+  using element = detail::validate_element<S>;
+  if constexpr(!element::trivial)
+  {
+    size_t done{};
+#ifdef RDK_X86_64
+    // there are no 128 bit lane compares, wide values are checked by the scalar kernel only
+    if constexpr(sizeof(typename element::native_type) <= sizeof(uint64_t))
+    {
+      if(detail::cpu.avx2)
+      {
+        done = detail::validate_avx2<S>(in.data(), in.size());
+      }
+    }
+#endif
+    done += detail::validate_scalar<S>(in.data() + done, in.size() - done);
+    if(done != in.size())
+    {
+      return first_bad_index{done};
+    }
+  }
+  // safe is layout compatible with its value type, and every value has been checked
+  return span<S const>{reinterpret_cast<S const *>(in.data()), in.size()};
+}
+
+} // namespace rdk
+
+#endif // !RDK_3116E7E3FC7A441BA3649E4EF2B269A5
@@ -0,0 +1,287 @@
+#pragma once
+#ifndef RDK_3F5E88C994A9470290B59D78E9006AE6
+#define RDK_3F5E88C994A9470290B59D78E9006AE6
+
+#include "packer.hpp"
+#include "safe_int.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+
+namespace rdk
+{
+
+/// safe integer restricted to the values min + k * step within [min, max], e.g. prices in ticks of 5
+/// packs the index k rather than the offset from min, so [0, 10000] in steps of 10 takes 10 bits instead of 14
+template<typename T, T min, T max, T step>
+class safe_stepped
+{
+public:
+  using value_type = T;
+  /// plain safe integer with the same range
+  using safe_type = safe<T, min, max>;
+
+  static constexpr T step_size = step;
+  /// largest index, i.e. (max - min) / step
+  static constexpr uintmax_t max_index = (static_cast<uintmax_t>(max) - static_cast<uintmax_t>(min)) / static_cast<uintmax_t>(step);
+
+  safe_stepped() = delete;
+
+  constexpr explicit safe_stepped(T v)
+    : v(v)
+  {
+    if((v < min) || (v > max) || !on_step(v))
+    {
+      detail::raise<std::domain_error>("SafeInt: value exceeds specified range or step.");
+    }
+  }
+
+  /// unchecked construction; asserts the value is in range and a multiple of step away from min
+  constexpr explicit safe_stepped(T v, unchecked_construct_t) noexcept
+    : v(v)
+  {
+    assert((v >= min) && (v <= max) && on_step(v));
+  }
+
+  constexpr explicit operator T() const noexcept
+  {
+    return v;
+  }
+
+  /// the value as a plain safe integer, for arithmetic with other safe integers
+  constexpr safe_type value() const noexcept
+  {
+    return safe_type{v, unchecked_construct};
+  }
+
+  /// (v - min) / step
+  constexpr uintmax_t index() const noexcept
+  {
+    return step_divider.divide(offset(v));
+  }
+
+  /// value with the given index
+  static constexpr safe_stepped from_index(uintmax_t i) noexcept
+  {
+    assert(i <= max_index);
+    return safe_stepped{static_cast<T>(static_cast<uintmax_t>(min) + (i * static_cast<uintmax_t>(step))), unchecked_construct};
+  }
+
+private:
+  /// indices are computed with a multiplication by the reciprocal of step instead of a division
+  static constexpr detail::divider step_divider{static_cast<uint64_t>(step)};
+
+  static constexpr uint64_t offset(T v) noexcept
+  {
+    return static_cast<uint64_t>(static_cast<uintmax_t>(v) - static_cast<uintmax_t>(min));
+  }
+
+  static constexpr bool on_step(T v) noexcept
+  {
+    return (step_divider.divide(offset(v)) * static_cast<uint64_t>(step)) == offset(v);
+  }
+
+  static_assert(std::is_integral_v<T>, "SafeInt: underlying storage must be an integral type");
+  static_assert(min <= max, "SafeInt: value range mustn't be empty");
+  static_assert(step > 0, "SafeInt: step must be positive");
+  static_assert(0U == ((static_cast<uintmax_t>(max) - static_cast<uintmax_t>(min)) % static_cast<uintmax_t>(step)), "SafeInt: max must be a whole number of steps away from min");
+
+  T v;
+};
+
+template<intmax_t min, intmax_t max, intmax_t step>
+using safe_stepped_signed = safe_stepped<typename detail::signed_type_from_range<min, max>::type, min, max, step>;
+
+template<uintmax_t min, uintmax_t max, uintmax_t step>
+using safe_stepped_unsigned = safe_stepped<typename detail::unsigned_type_from_range<min, max>::type, min, max, step>;
+
+namespace detail
+{
+  template<typename T, typename U, typename Op>
+  struct stepped_op
+  {
+    using safe_result = typename Op::result_type;
+    using value_type = typename safe_result::value_type;
+
+    static constexpr auto step = static_cast<value_type>(std::gcd(static_cast<uintmax_t>(T::step_size), static_cast<uintmax_t>(U::step_size)));
+    using result_type = safe_stepped<value_type, static_cast<value_type>(std::numeric_limits<safe_result>::min()), static_cast<value_type>(std::numeric_limits<safe_result>::max()), step>;
+
+    static constexpr result_type call(T lhs, U rhs) noexcept
+    {
+      return result_type{static_cast<value_type>(Op::call(lhs.value(), rhs.value())), unchecked_construct};
+    }
+  };
+} // namespace detail
+
+/// steps combine to their gcd, range and storage type are those of the plain safe operation
+template
+<
+  typename T, T minT, T maxT, T stepT
+, typename U, U minU, U maxU, U stepU
+>
+constexpr auto operator+(safe_stepped<T, minT, maxT, stepT> lhs, safe_stepped<U, minU, maxU, stepU> rhs) noexcept
+{
+  return detail::stepped_op<decltype(lhs), decltype(rhs), detail::add<safe<T, minT, maxT>, safe<U, minU, maxU>>>::call(lhs, rhs);
+}
+
+template
+<
+  typename T, T minT, T maxT, T stepT
+, typename U, U minU, U maxU, U stepU
+>
+constexpr auto operator-(safe_stepped<T, minT, maxT, stepT> lhs, safe_stepped<U, minU, maxU, stepU> rhs) noexcept
+{
+  return detail::stepped_op<decltype(lhs), decltype(rhs), detail::sub<safe<T, minT, maxT>, safe<U, minU, maxU>>>::call(lhs, rhs);
+}
+
+/// compare the underlying safe values, so mixed ranges and signedness are handled by safe
+template
+<
+  typename T, T minT, T maxT, T stepT
+, typename U, U minU, U maxU, U stepU
+>
+constexpr bool operator<(safe_stepped<T, minT, maxT, stepT> lhs, safe_stepped<U, minU, maxU, stepU> rhs)
+{
+  return (lhs.value() < rhs.value());
+}
+
+template
+<
+  typename T, T minT, T maxT, T stepT
+, typename U, U minU, U maxU, U stepU
+>
+constexpr bool operator>(safe_stepped<T, minT, maxT, stepT> lhs, safe_stepped<U, minU, maxU, stepU> rhs)
+{
+  return (lhs.value() > rhs.value());
+}
+
+template
+<
+  typename T, T minT, T maxT, T stepT
+, typename U, U minU, U maxU, U stepU
+>
+constexpr bool operator<=(safe_stepped<T, minT, maxT, stepT> lhs, safe_stepped<U, minU, maxU, stepU> rhs)
+{
+  return (lhs.value() <= rhs.value());
+}
+
+template
+<
+  typename T, T minT, T maxT, T stepT
+, typename U, U minU, U maxU, U stepU
+>
+constexpr bool operator>=(safe_stepped<T, minT, maxT, stepT> lhs, safe_stepped<U, minU, maxU, stepU> rhs)
+{
+  return (lhs.value() >= rhs.value());
+}
+
+template
+<
+  typename T, T minT, T maxT, T stepT
+, typename U, U minU, U maxU, U stepU
+>
+constexpr bool operator==(safe_stepped<T, minT, maxT, stepT> lhs, safe_stepped<U, minU, maxU, stepU> rhs)
+{
+  return (lhs.value() == rhs.value());
+}
+
+template
+<
+  typename T, T minT, T maxT, T stepT
+, typename U, U minU, U maxU, U stepU
+>
+constexpr bool operator!=(safe_stepped<T, minT, maxT, stepT> lhs, safe_stepped<U, minU, maxU, stepU> rhs)
+{
+  return (lhs.value() != rhs.value());
+}
+
+template<typename T, T min, T max, T step>
+struct is_packable<safe_stepped<T, min, max, step>> : std::true_type
+{
+};
+
+/// packs the index (v - min) / step
+template<typename T, T min, T max, T step>
+struct packable_traits<safe_stepped<T, min, max, step>>
+{
+  using value_type = safe_stepped<T, min, max, step>;
+
+  static constexpr uintmax_t packed_size = (0U != value_type::max_index) ? (1U + log2_v<value_type::max_index>) : 0U;
+  using packed_type = bitstream<packed_size>;
+
+  /// largest code produced by pack
+  static constexpr uint64_t max_code = static_cast<uint64_t>(value_type::max_index);
+
+  /// pack never produces codes past max_index, if there are any the all ones code marks an empty optional
+  static constexpr bool has_niche = (max_code < detail::low_mask(packed_size));
+
+  static constexpr packed_type niche() noexcept
+  {
+    return packed_type{detail::low_mask(packed_size)};
+  }
+
+  static constexpr bool is_niche(packed_type const &v) noexcept
+  {
+    return v.extract(0U, packed_size) == detail::low_mask(packed_size);
+  }
+
+  static constexpr packed_type pack(value_type const &v) noexcept
+  {
+    return packed_type{static_cast<uint64_t>(v.index())};
+  }
+
+  static constexpr value_type unpack(packed_type const &v) noexcept
+  {
+    return value_type::from_index(v.extract(0U, packed_size));
+  }
+
+  static void pack_into(std::byte *base, size_t bit_offset, value_type const &v) noexcept
+  {
+    detail::store_bits<packed_size>(base, bit_offset, static_cast<uint64_t>(v.index()));
+  }
+
+  static value_type unpack_from(std::byte const *base, size_t bit_offset) noexcept
+  {
+    return value_type::from_index(detail::load_bits<packed_size>(base, bit_offset));
+  }
+};
+
+} // namespace rdk
+
+namespace std
+{
+
+template<typename T, T minV, T maxV, T stepV>
+struct numeric_limits<::rdk::safe_stepped<T, minV, maxV, stepV>>
+  : public std::numeric_limits<T>
+{
+  using value_type = ::rdk::safe_stepped<T, minV, maxV, stepV>;
+
+  constexpr static bool traps = true;
+  constexpr static bool is_bounded = true;
+  constexpr static bool is_modulo = false;
+
+  constexpr static value_type min() noexcept
+  {
+    return value_type{minV, ::rdk::unchecked_construct};
+  }
+
+  constexpr static value_type lowest() noexcept
+  {
+    return min();
+  }
+
+  constexpr static value_type max() noexcept
+  {
+    return value_type{maxV, ::rdk::unchecked_construct};
+  }
+};
+
+} // namespace std
+
+#endif // !RDK_3F5E88C994A9470290B59D78E9006AE6
@@ -0,0 +1,125 @@
+#include "bit_io.hpp"
+#include "safe_int.hpp"
+
+#include <vector>
+
+TEST(BitIO, Layout)
+{
+  std::byte buffer[3]{};
+  rdk::bit_writer writer(buffer, sizeof(buffer));
+  writer.write(0x5U, 3U);
+  writer.write(0x1FFU, 9U);
+  writer.write(0x0U, 1U);
+  writer.write(0x7FU, 7U);
+  writer.flush();
+  EXPECT_EQ(20U, writer.bit_count());
+  EXPECT_EQ(3U, writer.byte_count());
+  // 101 | 111111111 | 0 | 1111111 read from the least significant bit of the first byte
+  EXPECT_EQ(std::byte{0xFD}, buffer[0]);
+  EXPECT_EQ(std::byte{0xEF}, buffer[1]);
+  EXPECT_EQ(std::byte{0x0F}, buffer[2]);
+
+  rdk::bit_reader reader(buffer, sizeof(buffer));
+  EXPECT_EQ(0x5U, reader.read(3U));
+  EXPECT_EQ(0x1FFU, reader.read(9U));
+  EXPECT_EQ(0x0U, reader.read(1U));
+  EXPECT_EQ(0x7FU, reader.read(7U));
+  EXPECT_EQ(20U, reader.bit_count());
+}
+
+TEST(BitIO, RandomWidths)
+{
+  constexpr size_t count = 100000U;
+  std::vector<size_t> widths(count);
+  std::vector<uint64_t> values(count);
+  std::uniform_int_distribution<size_t> width_dist(0U, 64U);
+  std::uniform_int_distribution<uint64_t> value_dist;
+  size_t total{};
+  for(size_t i{}; i < count; ++i)
+  {
+    widths[i] = width_dist(rng);
+    values[i] = value_dist(rng) & rdk::detail::low_mask(widths[i]);
+    total += widths[i];
+  }
+
+  // size the buffer exactly, so the last word is incomplete most of the time
+  std::vector<std::byte> buffer((total + 7U) / 8U);
+  rdk::bit_writer writer(buffer.data(), buffer.size());
+  for(size_t i{}; i < count; ++i)
+  {
+    writer.write(values[i], widths[i]);
+  }
+  writer.flush();
+  ASSERT_EQ(total, writer.bit_count());
+
+  rdk::bit_reader reader(buffer.data(), buffer.size());
+  for(size_t i{}; i < count; ++i)
+  {
+    ASSERT_EQ(values[i], reader.read(widths[i])) << i << ',' << widths[i];
+  }
+  ASSERT_EQ(total, reader.bit_count());
+}
+
+TEST(BitIO, SafeInt)
+{
+  using small_type = rdk::safe_signed<-3, 3>;
+  using medium_type = rdk::safe_unsigned<100U, 1000U>;
+  using large_type = rdk::safe_signed<std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max()>;
+  constexpr size_t record_size = rdk::packable_traits<small_type>::packed_size
+    + rdk::packable_traits<medium_type>::packed_size
+    + rdk::packable_traits<large_type>::packed_size;
+  static_assert(record_size == (3U + 10U + 64U), "SafeInt shall be written with its packed size");
+
+  constexpr size_t count = 10000U;
+  std::uniform_int_distribution<int> small_dist(-3, 3);
+  std::uniform_int_distribution<unsigned> medium_dist(100U, 1000U);
+  std::uniform_int_distribution<int64_t> large_dist(std::numeric_limits<int64_t>::min());
+  std::vector<small_type> small;
+  std::vector<medium_type> medium;
+  std::vector<large_type> large;
+  for(size_t i{}; i < count; ++i)
+  {
+    small.emplace_back(static_cast<int8_t>(small_dist(rng)));
+    medium.emplace_back(static_cast<uint16_t>(medium_dist(rng)));
+    large.emplace_back(large_dist(rng));
+  }
+
+  std::vector<std::byte> buffer(((count * record_size) + 7U) / 8U);
+  rdk::bit_writer writer(buffer.data(), buffer.size());
+  for(size_t i{}; i < count; ++i)
+  {
+    writer.write(small[i]);
+    writer.write(medium[i]);
+    writer.write(large[i]);
+  }
+  writer.flush();
+  ASSERT_EQ(count * record_size, writer.bit_count());
+
+  rdk::bit_reader reader(buffer.data(), buffer.size());
+  for(size_t i{}; i < count; ++i)
+  {
+    ASSERT_EQ(small[i], reader.read<small_type>()) << i;
+    ASSERT_EQ(medium[i], reader.read<medium_type>()) << i;
+    ASSERT_EQ(large[i], reader.read<large_type>()) << i;
+  }
+}
+
+TEST(BitIO, Bitstream)
+{
+  rdk::bitstream<150> value;
+  value.insert(0U, 64U, 0x0123456789ABCDEFU);
+  value.insert(64U, 64U, 0xFEDCBA9876543210U);
+  value.insert(128U, 22U, 0x2AAAAAU);
+
+  std::byte buffer[40]{};
+  rdk::bit_writer writer(buffer, sizeof(buffer));
+  writer.write(0x1U, 1U);
+  writer.write(value);
+  writer.write(value);
+  writer.flush();
+
+  rdk::bit_reader reader(buffer, sizeof(buffer));
+  EXPECT_EQ(0x1U, reader.read(1U));
+  EXPECT_EQ(value, reader.read<rdk::bitstream<150>>());
+  EXPECT_EQ(value, reader.read<rdk::bitstream<150>>());
+}
@@ -0,0 +1,102 @@
+#include "field_codec.hpp"
+#include "safe_int.hpp"
+
+#include <vector>
+
+namespace
+{
+  template<typename Codec, size_t... Is>
+  void TestCodec(std::index_sequence<Is...>)
+  {
+    using value_type = typename Codec::value_type;
+    std::uniform_int_distribution<uint64_t> word_dist;
+    for(size_t i{}; i < 10000U; ++i)
+    {
+      value_type const v{RandomValue<std::tuple_element_t<Is, value_type>>()...};
+
+      // the packed word shall be the concatenation of the fields' packed representations
+      uint64_t expected{};
+      (void)std::initializer_list<int>{(expected |= (rdk::packable_traits<std::tuple_element_t<Is, value_type>>::pack(std::get<Is>(v)).extract(0U, rdk::packable_traits<std::tuple_element_t<Is, value_type>>::packed_size) << Codec::template offset<Is>), 0)...};
+      uint64_t const packed = Codec::pack(v);
+      ASSERT_EQ(expected, packed);
+      ASSERT_EQ(packed, Codec::pack(std::get<Is>(v)...));
+      ASSERT_TRUE(v == Codec::unpack(packed));
+
+      if constexpr(Codec::has_lanes)
+      {
+        // kernels shall agree on arbitrary input, including lanes that are out of range
+        uint64_t const word = word_dist(rng);
+        ASSERT_EQ(Codec::pack_lanes_portable(word), Codec::pack_lanes(word));
+        ASSERT_EQ(Codec::unpack_lanes_portable(word), Codec::unpack_lanes(word));
+#ifdef RDK_X86_64
+        if(rdk::detail::cpu.bmi2)
+        {
+          ASSERT_EQ(Codec::pack_lanes_portable(word), Codec::pack_lanes_bmi2(word));
+          ASSERT_EQ(Codec::unpack_lanes_portable(word), Codec::unpack_lanes_bmi2(word));
+        }
+#endif
+        ASSERT_EQ(packed, Codec::pack_lanes(Codec::unpack_lanes(packed)));
+      }
+    }
+  }
+
+  template<typename... Ps>
+  void TestCodec()
+  {
+    TestCodec<rdk::field_codec<Ps...>>(std::index_sequence_for<Ps...>{});
+  }
+}
+
+TEST(FieldCodec, Layout)
+{
+  using codec = rdk::field_codec<rdk::safe_unsigned<0U, 15U>, rdk::safe_signed<-8, 7>, rdk::safe_unsigned<1000U, 1001U>>;
+  static_assert(codec::packed_size == 9U, "fields shall be packed densely");
+  static_assert(codec::offset<0> == 0U, "first field shall be stored in the lowest bits");
+  static_assert(codec::offset<1> == 4U, "fields shall be stored back to back");
+  static_assert(codec::offset<2> == 8U, "fields shall be stored back to back");
+  static_assert(codec::lane_offset<2> == 16U, "lanes shall be stored back to back");
+  static_assert(codec::has_lanes, "lanes shall fit into a word");
+
+  uint64_t const packed = codec::pack(rdk::safe_unsigned<0U, 15U>{5U}, rdk::safe_signed<-8, 7>{-8}, rdk::safe_unsigned<1000U, 1001U>{1001U});
+  EXPECT_EQ(0x105U, packed);
+  // lanes: uint8_t 5, int8_t -8, uint16_t 1001
+  EXPECT_EQ(0x03E9F805U, codec::unpack_lanes(packed));
+}
+
+TEST(FieldCodec, RoundTrip)
+{
+  TestCodec<rdk::safe_unsigned<0U, 1U>>();
+  TestCodec<rdk::safe_unsigned<0U, 15U>, rdk::safe_signed<-8, 7>, rdk::safe_unsigned<3U, 100U>>();
+  TestCodec<rdk::safe_signed<-1, -1>, rdk::safe_signed<-100, 100>, rdk::safe_signed<-1000, 1000>, rdk::safe_unsigned<0U, 255U>, rdk::safe_signed<-128, 127>>();
+  TestCodec<rdk::safe_signed<-2000000000, 2000000000>, rdk::safe_unsigned<0U, 0xFFFFFFU>, rdk::safe_signed<-10, 10>>();
+  TestCodec<rdk::safe_unsigned<0U, std::numeric_limits<uint64_t>::max()>>();
+  TestCodec<rdk::safe_signed<std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max()>>();
+  // native values exceed a word, only the portable path applies
+  TestCodec<rdk::safe_signed<-1, 1>, rdk::safe_unsigned<0U, 3U>, rdk::safe_signed<std::numeric_limits<int64_t>::min() + 1, std::numeric_limits<int64_t>::min() + 100>>();
+}
+
+TEST(FieldCodec, Batch)
+{
+  using codec = rdk::field_codec<rdk::safe_unsigned<0U, 5U>, rdk::safe_unsigned<0U, 5U>, rdk::safe_unsigned<0U, 5U>, rdk::safe_unsigned<0U, 5U>, rdk::safe_unsigned<10U, 20U>, rdk::safe_unsigned<10U, 20U>, rdk::safe_unsigned<10U, 20U>, rdk::safe_unsigned<10U, 20U>>;
+  constexpr size_t count = 1000U;
+  std::uniform_int_distribution<unsigned> small_dist(0U, 5U);
+  std::uniform_int_distribution<unsigned> large_dist(10U, 20U);
+  std::vector<uint64_t> lanes(count);
+  for(auto &l : lanes)
+  {
+    for(size_t i{}; i < 8U; ++i)
+    {
+      l |= static_cast<uint64_t>((i < 4U) ? small_dist(rng) : large_dist(rng)) << (8U * i);
+    }
+  }
+
+  std::vector<uint64_t> packed(count);
+  codec::pack_lanes(lanes.data(), packed.data(), count);
+  std::vector<uint64_t> unpacked(count);
+  codec::unpack_lanes(packed.data(), unpacked.data(), count);
+  for(size_t i{}; i < count; ++i)
+  {
+    ASSERT_EQ(codec::pack_lanes_portable(lanes[i]), packed[i]);
+    ASSERT_EQ(lanes[i], unpacked[i]);
+  }
+}
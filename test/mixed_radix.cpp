@@ -0,0 +1,154 @@
+#include "mixed_radix.hpp"
+#include "packed_enum.hpp"
+#include "packed_struct.hpp"
+#include "packed_tuple.hpp"
+#include "safe_int.hpp"
+
+#include <array>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+namespace
+{
+  template<typename... Ps>
+  void TestMixedRadix(size_t expected_size)
+  {
+    using value_type = rdk::mixed_radix<std::tuple<Ps...>>;
+    std::vector<value_type> values;
+    for(size_t i{}; i < 1000U; ++i)
+    {
+      values.push_back(std::tuple<Ps...>{RandomCorner<Ps>()...});
+    }
+    TestRoundTrip(values, expected_size, 5U);
+  }
+
+  enum class level
+  {
+    low,
+    medium,
+    high,
+  };
+
+  struct reading
+  {
+    rdk::safe_unsigned<0U, 2U> state;
+    rdk::safe_signed<-50, 50> delta;
+    rdk::safe_unsigned<0U, 9U> digit;
+
+    friend bool operator==(reading const &lhs, reading const &rhs) noexcept
+    {
+      return (lhs.state == rhs.state) && (lhs.delta == rhs.delta) && (lhs.digit == rhs.digit);
+    }
+  };
+}
+
+template<>
+struct rdk::enum_traits<level> : rdk::enum_range<level, level::low, level::high>
+{
+};
+
+template<>
+struct rdk::packable_fields<reading> : rdk::packed_fields<&reading::state, &reading::delta, &reading::digit>
+{
+};
+
+TEST(MixedRadix, Divider)
+{
+  std::uniform_int_distribution<uint64_t> dist;
+  std::vector<uint64_t> divisors{1U, 2U, 3U, 5U, 7U, 10U, 11U, 64U, 100U, 641U, 1000000007U, (uint64_t{1U} << 32U) + 1U, (uint64_t{1U} << 63U), (uint64_t{1U} << 63U) + 1U, ~uint64_t{} - 1U, ~uint64_t{}};
+  for(size_t i{}; i < 100U; ++i)
+  {
+    divisors.push_back(dist(rng) >> (i % 64U));
+  }
+  for(uint64_t d : divisors)
+  {
+    if(0U == d)
+    {
+      continue;
+    }
+    rdk::detail::divider const div{d};
+    for(uint64_t n : {uint64_t{0U}, uint64_t{1U}, d - 1U, d, d + 1U, ~uint64_t{}, ~uint64_t{} - 1U, ~uint64_t{} - d})
+    {
+      ASSERT_EQ(n / d, div.divide(n)) << n << '/' << d;
+    }
+    for(size_t j{}; j < 1000U; ++j)
+    {
+      uint64_t const n = dist(rng);
+      ASSERT_EQ(n / d, div.divide(n)) << n << '/' << d;
+    }
+  }
+  static_assert(rdk::detail::divider{7U}.divide(700U) == 100U, "division shall be constexpr");
+}
+
+TEST(MixedRadix, Layout)
+{
+  using trit = rdk::safe_unsigned<0U, 2U>;
+  using type = rdk::mixed_radix<std::tuple<trit, trit, trit, trit, trit>>;
+  using traits = rdk::packable_traits<type>;
+  static_assert(traits::packed_size == 8U, "five trits shall fit into a byte");
+  static_assert(traits::group_count == 1U, "small records shall form a single group");
+  static_assert(rdk::packable_traits<std::tuple<trit, trit, trit, trit, trit>>::packed_size == 10U, "tuples shall keep whole bit fields");
+
+  // first field least significant: 2 + 3 * (1 + 3 * (0 + 3 * (2 + 3 * 1))) = 140
+  constexpr auto packed = traits::pack(type{trit{uint8_t{2U}}, trit{uint8_t{1U}}, trit{uint8_t{0U}}, trit{uint8_t{2U}}, trit{uint8_t{1U}}});
+  static_assert(packed.extract(0U, 8U) == 140U, "fields shall be combined in base 3");
+  static_assert(std::get<3>(traits::unpack(packed)) == trit{uint8_t{2U}}, "unpacking shall be constexpr");
+
+  // 10^19 < 2^64 < 10^20: 20 digits split into a group of 19 (64 bits) and a group of one (4 bits)
+  using digits = rdk::mixed_radix<decltype(std::tuple_cat(std::declval<std::array<rdk::safe_unsigned<0U, 9U>, 20U>>()))>;
+  static_assert(rdk::packable_traits<digits>::group_count == 2U, "groups shall not exceed a word");
+  static_assert(rdk::packable_traits<digits>::packed_size == 68U, "groups shall not exceed a word");
+
+  // a constant after a whole word field can't join its group, the whole word field would need a radix of 2^64
+  using full = rdk::safe_unsigned<0U, std::numeric_limits<uint64_t>::max()>;
+  using constant = rdk::safe_unsigned<5U, 5U>;
+  using whole_word = rdk::packable_traits<rdk::mixed_radix<std::tuple<full, constant>>>;
+  static_assert(whole_word::group_count == 2U, "whole word fields shall end their group");
+  static_assert(whole_word::packed_size == 64U, "constants shall take no bits");
+  static_assert(std::get<0>(whole_word::unpack(whole_word::pack(std::tuple<full, constant>{full{~uint64_t{}}, constant{uint8_t{5U}}}))) == full{~uint64_t{}}, "whole word fields shall round trip");
+}
+
+TEST(MixedRadix, RoundTrip)
+{
+  using trit = rdk::safe_unsigned<0U, 2U>;
+  TestMixedRadix<trit, trit, trit, trit, trit>(8U);
+  TestMixedRadix<rdk::safe_signed<-1, 1>, rdk::safe_unsigned<0U, 9U>, rdk::safe_unsigned<7U, 7U>, rdk::safe_signed<-500, 499>>(15U);
+  // 3 * 10^19 exceeds a word: the third field starts a new group
+  TestMixedRadix<trit, rdk::safe_unsigned<0U, 9999999999999999999U>, rdk::safe_unsigned<0U, 9U>>(66U + 4U);
+  // whole word fields are groups of their own
+  TestMixedRadix<trit, rdk::safe_unsigned<0U, std::numeric_limits<uint64_t>::max()>, trit, rdk::safe_signed<std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max()>>(2U + 64U + 2U + 64U);
+  TestMixedRadix<rdk::safe_unsigned<0U, std::numeric_limits<uint64_t>::max()>, rdk::safe_unsigned<5U, 5U>, trit>(64U + 2U);
+}
+
+TEST(MixedRadix, Struct)
+{
+  using type = rdk::mixed_radix<reading>;
+  using traits = rdk::packable_traits<type>;
+  // 3 * 101 * 10 = 3030 codes in 12 bits instead of 2 + 7 + 4 = 13
+  static_assert(traits::packed_size == 12U, "registered structs shall support mixed radix packing");
+  static_assert(rdk::packable_traits<reading>::packed_size == 13U, "registered structs shall keep whole bit fields");
+
+  for(size_t i{}; i < 1000U; ++i)
+  {
+    type const v{reading{RandomValue<rdk::safe_unsigned<0U, 2U>>(), RandomValue<rdk::safe_signed<-50, 50>>(), RandomValue<rdk::safe_unsigned<0U, 9U>>()}};
+    ASSERT_TRUE(v == traits::unpack(traits::pack(v)));
+  }
+}
+
+TEST(MixedRadix, Checked)
+{
+  using trit = rdk::safe_unsigned<0U, 2U>;
+  using type = rdk::mixed_radix<std::tuple<trit, level>>;
+  using traits = rdk::packable_traits<type>;
+  static_assert(traits::packed_size == 4U, "enums shall take part in mixed radix packing");
+  static_assert(!noexcept(traits::pack(std::declval<type const &>())), "checked fields shall make packing throw");
+  static_assert(noexcept(rdk::packable_traits<rdk::mixed_radix<std::tuple<trit, trit>>>::pack(std::declval<rdk::mixed_radix<std::tuple<trit, trit>> const &>())), "unchecked fields shall not");
+
+  type const good{trit{uint8_t{2U}}, level::high};
+  ASSERT_TRUE(good == traits::unpack(traits::pack(good)));
+  type const bad{trit{uint8_t{1U}}, static_cast<level>(3)};
+  EXPECT_THROW(traits::pack(bad), std::domain_error);
+  std::byte buffer[2]{};
+  EXPECT_THROW(rdk::pack_into(buffer, 3U, bad), std::domain_error);
+}
@@ -0,0 +1,185 @@
+#include "packed_bulk.hpp"
+#include "packed_vector.hpp"
+#include "safe_int.hpp"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace
+{
+  template<typename S>
+  std::vector<S> RandomValues(size_t count)
+  {
+    std::vector<S> res;
+    for(size_t i{}; i < count; ++i)
+    {
+      res.push_back(RandomValue<S>());
+    }
+    return res;
+  }
+
+  template<typename S, typename Kernel>
+  void TestUnpackKernel(rdk::packed_span<S> in, std::vector<S> const &expected, Kernel &&kernel)
+  {
+    std::vector<S> out(in.size(), std::numeric_limits<S>::max());
+    size_t const done = kernel(in.data(), in.word_count(), in.offset(), out.data(), in.size());
+    rdk::detail::unpack_bulk_scalar(in.data(), in.offset() + done, out.data() + done, in.size() - done);
+    ASSERT_TRUE(expected == out) << rdk::packable_traits<S>::packed_size << ',' << in.offset() << ',' << in.size();
+  }
+
+  template<typename S>
+  void TestUnpack()
+  {
+    auto const values = RandomValues<S>(1000U);
+    rdk::packed_vector<S> packed(values.begin(), values.end());
+
+    // all alignments of the first element and all tail lengths
+    for(size_t first{}; first < 9U; ++first)
+    {
+      for(size_t n : {size_t{0U}, size_t{1U}, size_t{7U}, size_t{8U}, size_t{9U}, size_t{500U}, values.size() - first})
+      {
+        auto const in = packed.span().subspan(first, n);
+        std::vector<S> const expected(values.begin() + static_cast<ptrdiff_t>(first), values.begin() + static_cast<ptrdiff_t>(first + n));
+
+        std::vector<S> out(n, std::numeric_limits<S>::max());
+        rdk::unpack_bulk(in, out.data(), n);
+        ASSERT_TRUE(expected == out) << rdk::packable_traits<S>::packed_size << ',' << first << ',' << n;
+
+#ifdef RDK_X86_64
+        if(rdk::detail::cpu.avx2)
+        {
+          TestUnpackKernel(in, expected, [](auto &&... args) { return rdk::detail::unpack_bulk_avx2(args...); });
+        }
+        if(rdk::detail::cpu.avx512f)
+        {
+          TestUnpackKernel(in, expected, [](auto &&... args) { return rdk::detail::unpack_bulk_avx512(args...); });
+        }
+#endif
+      }
+    }
+  }
+
+  template<typename S, typename Kernel>
+  void TestPackKernel(std::vector<S> const &values, std::vector<uint64_t> const &expected, Kernel &&kernel)
+  {
+    constexpr size_t block = rdk::detail::pack_block_size;
+    constexpr size_t width = rdk::packable_traits<S>::packed_size;
+    std::vector<uint64_t> out(expected.size() + 1U, ~uint64_t{});
+    kernel(values.data(), values.size() / block, out.data());
+    rdk::detail::pack_bulk_tail<S>(values.data() + ((values.size() / block) * block), values.size() % block, out.data() + ((values.size() / block) * width));
+    ASSERT_EQ(~uint64_t{}, out.back());
+    out.pop_back();
+    ASSERT_TRUE(expected == out) << width << ',' << values.size();
+  }
+
+  template<typename S>
+  void TestPack()
+  {
+    using value_type = typename S::value_type;
+    constexpr size_t width = rdk::packable_traits<S>::packed_size;
+    auto const all_values = RandomValues<S>(1000U);
+
+    for(size_t n : {size_t{0U}, size_t{1U}, size_t{63U}, size_t{64U}, size_t{65U}, size_t{200U}, all_values.size()})
+    {
+      std::vector<S> const values(all_values.begin(), all_values.begin() + static_cast<ptrdiff_t>(n));
+      rdk::packed_vector<S> const packed(values.begin(), values.end());
+      std::vector<uint64_t> const expected(packed.data(), packed.data() + (((n * width) + 63U) / 64U));
+
+      // never writes past the last spanned word
+      std::vector<uint64_t> out(expected.size() + 1U, ~uint64_t{});
+      rdk::pack_bulk(values.data(), n, out.data());
+      ASSERT_EQ(~uint64_t{}, out.back());
+      out.pop_back();
+      ASSERT_TRUE(expected == out) << width << ',' << n;
+
+      std::vector<value_type> raw;
+      for(auto const &v : values)
+      {
+        raw.push_back(static_cast<value_type>(v));
+      }
+      std::fill(out.begin(), out.end(), ~uint64_t{});
+      rdk::pack_bulk<S>(raw.data(), n, out.data());
+      ASSERT_TRUE(expected == out) << width << ',' << n;
+      std::fill(out.begin(), out.end(), ~uint64_t{});
+      rdk::pack_bulk<S>(raw.data(), n, out.data(), rdk::unchecked_construct);
+      ASSERT_TRUE(expected == out) << width << ',' << n;
+
+      TestPackKernel(values, expected, [](auto &&... args) { rdk::detail::pack_bulk_scalar<S>(args...); });
+#ifdef RDK_X86_64
+      if(rdk::detail::cpu.avx2)
+      {
+        TestPackKernel(values, expected, [](auto &&... args) { rdk::detail::pack_bulk_avx2<S>(args...); });
+      }
+      if(rdk::detail::cpu.avx512f)
+      {
+        TestPackKernel(values, expected, [](auto &&... args) { rdk::detail::pack_bulk_avx512<S>(args...); });
+      }
+#endif
+    }
+  }
+
+  template<size_t width>
+  using unsigned_of_width = rdk::safe_unsigned<7U, 7U + (std::numeric_limits<uint64_t>::max() >> (64U - width)) - ((64U == width) ? 7U : 0U)>;
+
+  template<size_t width>
+  using signed_of_width = rdk::safe_signed<-static_cast<intmax_t>((uint64_t{1U} << (width - 1U)) - 1U) - 1, static_cast<intmax_t>((uint64_t{1U} << (width - 1U)) - 1U)>;
+
+  template<size_t... widths>
+  void TestUnpackWidths(std::index_sequence<widths...>)
+  {
+    (TestUnpack<unsigned_of_width<widths + 1U>>(), ...);
+    (TestUnpack<signed_of_width<widths + 1U>>(), ...);
+  }
+
+  template<size_t... widths>
+  void TestPackWidths(std::index_sequence<widths...>)
+  {
+    (TestPack<unsigned_of_width<widths + 1U>>(), ...);
+    (TestPack<signed_of_width<widths + 1U>>(), ...);
+  }
+}
+
+TEST(PackedBulk, UnpackAllWidths)
+{
+  TestUnpackWidths(std::make_index_sequence<64>{});
+}
+
+TEST(PackedBulk, UnpackWideStorage)
+{
+  // narrow ranges in wide native types
+  TestUnpack<rdk::safe<int64_t, -1000, 1000>>();
+  TestUnpack<rdk::safe<uint32_t, 0U, 1U>>();
+  TestUnpack<rdk::safe<int16_t, 100, 107>>();
+  TestUnpack<rdk::safe<int32_t, -3, -3>>();
+}
+
+
+TEST(PackedBulk, PackAllWidths)
+{
+  TestPackWidths(std::make_index_sequence<64>{});
+}
+
+TEST(PackedBulk, PackWideStorage)
+{
+  TestPack<rdk::safe<int64_t, -1000, 1000>>();
+  TestPack<rdk::safe<uint32_t, 0U, 1U>>();
+  TestPack<rdk::safe<int16_t, 100, 107>>();
+  TestPack<rdk::safe<int32_t, -3, -3>>();
+  TestPack<rdk::safe<uint8_t, 0U, 255U>>();
+}
+
+TEST(PackedBulk, PackChecked)
+{
+  using S = rdk::safe<int16_t, -100, 100>;
+  std::vector<int16_t> raw(300U, 5);
+  std::vector<uint64_t> out(((raw.size() * rdk::packable_traits<S>::packed_size) + 63U) / 64U, 0U);
+  raw[257] = 101;
+  ASSERT_THROW(rdk::pack_bulk<S>(raw.data(), raw.size(), out.data()), std::domain_error);
+  ASSERT_TRUE(std::all_of(out.begin(), out.end(), [](uint64_t w) { return 0U == w; }));
+  raw[257] = -101;
+  ASSERT_THROW(rdk::pack_bulk<S>(raw.data(), raw.size(), out.data()), std::domain_error);
+  raw[257] = -100;
+  rdk::pack_bulk<S>(raw.data(), raw.size(), out.data());
+  ASSERT_EQ(-100, static_cast<int16_t>(rdk::packed_span<S>(out.data(), raw.size())[257]));
+}
@@ -0,0 +1,120 @@
+#include "bit_io.hpp"
+#include "packed_enum.hpp"
+#include "packed_optional.hpp"
+#include "packed_tuple.hpp"
+#include "packed_vector.hpp"
+
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace
+{
+  enum class color : uint8_t
+  {
+    red,
+    green,
+    blue,
+  };
+
+  enum class level : int
+  {
+    trace = -2,
+    debug,
+    info,
+    warning,
+    error,
+  };
+
+  enum opcode : uint16_t
+  {
+    op_first = 100U,
+    op_last = 140U,
+  };
+
+  enum class unregistered
+  {
+    a,
+  };
+}
+
+template<>
+struct rdk::enum_traits<color> : rdk::dense_enum_range<color, color::red, color::blue>
+{
+};
+
+template<>
+struct rdk::enum_traits<level> : rdk::enum_range<level, level::trace, level::error>
+{
+};
+
+template<>
+struct rdk::enum_traits<opcode> : rdk::enum_range<opcode, op_first, op_last>
+{
+};
+
+TEST(PackedEnum, Layout)
+{
+  static_assert(rdk::is_packable_v<color>, "registered enums shall be packable");
+  static_assert(!rdk::is_packable_v<unregistered>, "enums shall only be packable once registered");
+  static_assert(rdk::packable_traits<color>::packed_size == 2U, "enums shall take as many bits as their range needs");
+  static_assert(rdk::packable_traits<level>::packed_size == 3U, "enums shall take as many bits as their range needs");
+  static_assert(rdk::packable_traits<opcode>::packed_size == 6U, "enums shall take as many bits as their range needs");
+  static_assert(rdk::packable_traits<level>::pack(level::trace).extract(0U, 3U) == 0U, "codes shall be relative to the first value");
+  static_assert(rdk::packable_traits<level>::unpack(rdk::packable_traits<level>::pack(level::warning)) == level::warning, "packing shall be constexpr");
+  static_assert(noexcept(rdk::packable_traits<color>::pack(color::red)), "dense enums shall not be checked");
+  static_assert(!noexcept(rdk::packable_traits<level>::pack(level::info)), "enums shall be checked by default");
+  // color has a spare code, so optional colors take no extra bit
+  static_assert(rdk::packable_traits<std::optional<color>>::packed_size == 2U, "enums shall provide niches");
+}
+
+TEST(PackedEnum, RoundTrip)
+{
+  using record = std::tuple<color, level, opcode>;
+  std::vector<record> values;
+  for(size_t i{}; i < 1000U; ++i)
+  {
+    values.emplace_back(static_cast<color>(rng() % 3U), static_cast<level>(static_cast<int>(rng() % 5U) - 2), static_cast<opcode>(100U + (rng() % 41U)));
+  }
+
+  rdk::packed_vector<record> const packed(values.begin(), values.end());
+  ASSERT_EQ(((values.size() * 11U) + 63U) / 64U, packed.word_count());
+  ASSERT_TRUE(std::equal(values.begin(), values.end(), packed.begin()));
+
+  std::vector<std::byte> buffer(((values.size() * 11U) + 7U) / 8U);
+  rdk::bit_writer writer(buffer.data(), buffer.size());
+  for(auto const &v : values)
+  {
+    writer.write(v);
+  }
+  writer.flush();
+  rdk::bit_reader reader(buffer.data(), buffer.size());
+  for(size_t i{}; i < values.size(); ++i)
+  {
+    ASSERT_TRUE(values[i] == reader.read<record>());
+    ASSERT_EQ(std::get<1>(values[i]), rdk::unpack_from<level>(buffer.data(), (i * 11U) + 2U));
+  }
+}
+
+TEST(PackedEnum, Checked)
+{
+  ASSERT_THROW(rdk::packable_traits<level>::pack(static_cast<level>(3)), std::domain_error);
+  ASSERT_THROW(rdk::packable_traits<level>::pack(static_cast<level>(-3)), std::domain_error);
+  ASSERT_THROW(rdk::packable_traits<opcode>::pack(static_cast<opcode>(99U)), std::domain_error);
+  std::byte buffer[2]{};
+  ASSERT_THROW(rdk::pack_into(buffer, 3U, static_cast<opcode>(141U)), std::domain_error);
+  rdk::pack_into(buffer, 3U, static_cast<opcode>(140U));
+  ASSERT_EQ(static_cast<opcode>(140U), rdk::unpack_from<opcode>(buffer, 3U));
+
+  // containers shall propagate the error and stay unchanged
+  static_assert(!noexcept(std::declval<rdk::packed_vector<level>::reference>() = level::info), "assigning checked enums shall throw");
+  rdk::packed_vector<level> levels;
+  levels.push_back(level::info);
+  EXPECT_THROW(levels[0] = static_cast<level>(3), std::domain_error);
+  EXPECT_THROW(levels.push_back(static_cast<level>(-3)), std::domain_error);
+  EXPECT_THROW(levels.resize(10U, static_cast<level>(3)), std::domain_error);
+  ASSERT_EQ(1U, levels.size());
+  ASSERT_EQ(1U, levels.word_count());
+  ASSERT_EQ(level::info, levels[0]);
+}
@@ -0,0 +1,86 @@
+#include "packed_optional.hpp"
+#include "packed_tuple.hpp"
+#include "safe_int.hpp"
+
+#include <optional>
+#include <tuple>
+#include <vector>
+
+namespace
+{
+  template<typename T>
+  std::optional<T> RandomOptional()
+  {
+    // the extremes are the codes next to the niche
+    if(0U == (rng() % 8U))
+    {
+      return std::nullopt;
+    }
+    return RandomCorner<T>();
+  }
+
+  template<typename T>
+  void TestOptional(size_t expected_size)
+  {
+    std::vector<std::optional<T>> values;
+    for(size_t i{}; i < 1000U; ++i)
+    {
+      values.push_back(RandomOptional<T>());
+    }
+    TestRoundTrip(values, expected_size, 1U);
+  }
+}
+
+TEST(PackedOptional, Niche)
+{
+  // ranges that don't fill their code space store nullopt in the spare all ones code
+  TestOptional<rdk::safe_unsigned<0U, 1000U>>(10U);
+  TestOptional<rdk::safe_signed<-100, 100>>(8U);
+  TestOptional<rdk::safe_unsigned<5U, 7U>>(2U);
+  TestOptional<rdk::safe_signed<std::numeric_limits<int64_t>::min() + 1, std::numeric_limits<int64_t>::max()>>(64U);
+
+  using traits = rdk::packable_traits<std::optional<rdk::safe_unsigned<0U, 1000U>>>;
+  static_assert(traits::uses_niche, "spare codes shall be used as niche");
+  static_assert(traits::pack(std::nullopt).extract(0U, 10U) == 0x3FFU, "nullopt shall be the all ones code");
+  static_assert(!traits::unpack(traits::pack(std::nullopt)).has_value(), "unpacking shall be constexpr");
+}
+
+TEST(PackedOptional, PresenceBit)
+{
+  // ranges filling their code space need an extra bit
+  TestOptional<rdk::safe_unsigned<0U, 1023U>>(11U);
+  TestOptional<rdk::safe_signed<-128, 127>>(9U);
+  TestOptional<rdk::safe_unsigned<3U, 3U>>(1U);
+  TestOptional<rdk::safe_unsigned<0U, std::numeric_limits<uint64_t>::max()>>(65U);
+
+  using traits = rdk::packable_traits<std::optional<rdk::safe_unsigned<0U, 1023U>>>;
+  static_assert(!traits::uses_niche, "full ranges shall not have a niche");
+  static_assert(traits::pack(std::nullopt).extract(0U, 11U) == 0U, "nullopt shall clear the presence bit");
+  static_assert(traits::pack(rdk::safe_unsigned<0U, 1023U>{uint16_t{5U}}).extract(0U, 11U) == 0xBU, "values shall follow the presence bit");
+}
+
+TEST(PackedOptional, Records)
+{
+  // records borrow the niche of their first field that has one
+  using record = std::tuple<rdk::safe_unsigned<0U, 255U>, rdk::safe_signed<-5, 5>, rdk::safe_unsigned<0U, 1000U>>;
+  using traits = rdk::packable_traits<std::optional<record>>;
+  static_assert(traits::uses_niche, "records shall borrow a niche from their fields");
+  static_assert(traits::packed_size == rdk::packable_traits<record>::packed_size, "borrowed niches shall not cost storage");
+
+  for(size_t i{}; i < 1000U; ++i)
+  {
+    auto const a = RandomOptional<rdk::safe_signed<-5, 5>>();
+    auto const b = RandomOptional<rdk::safe_unsigned<0U, 1000U>>();
+    std::optional<record> const v = (a && b) ? std::optional<record>{record{rdk::safe_unsigned<0U, 255U>{static_cast<uint8_t>(i)}, *a, *b}} : std::nullopt;
+    ASSERT_TRUE(v == traits::unpack(traits::pack(v)));
+  }
+
+  // optionals have no niche themselves, nesting them costs a presence bit
+  using nested = std::optional<std::optional<rdk::safe_unsigned<0U, 1000U>>>;
+  using nested_traits = rdk::packable_traits<nested>;
+  static_assert(nested_traits::packed_size == 11U, "nested optionals shall use a presence bit");
+  nested const outer_empty{};
+  nested const inner_empty{std::optional<rdk::safe_unsigned<0U, 1000U>>{}};
+  ASSERT_TRUE(outer_empty == nested_traits::unpack(nested_traits::pack(outer_empty)));
+  ASSERT_TRUE(inner_empty == nested_traits::unpack(nested_traits::pack(inner_empty)));
+}
@@ -0,0 +1,128 @@
+#include "bit_io.hpp"
+#include "packed_struct.hpp"
+#include "packed_tuple.hpp"
+#include "packed_vector.hpp"
+#include "safe_int.hpp"
+
+#include <vector>
+
+namespace
+{
+  struct sample
+  {
+    rdk::safe_unsigned<0U, 15U> channel;
+    rdk::safe_signed<-1000, 1000> value;
+    rdk::safe_unsigned<0U, 1U> valid;
+
+    friend bool operator==(sample const &lhs, sample const &rhs) noexcept
+    {
+      return (lhs.channel == rhs.channel) && (lhs.value == rhs.value) && (lhs.valid == rhs.valid);
+    }
+  };
+
+  struct record
+  {
+    rdk::safe_unsigned<0U, std::numeric_limits<uint64_t>::max()> id;
+    sample first;
+    sample second;
+
+    friend bool operator==(record const &lhs, record const &rhs) noexcept
+    {
+      return (lhs.id == rhs.id) && (lhs.first == rhs.first) && (lhs.second == rhs.second);
+    }
+  };
+
+  struct unregistered
+  {
+    rdk::safe_unsigned<0U, 15U> channel;
+  };
+
+  sample RandomSample()
+  {
+    std::uniform_int_distribution<unsigned> channel_dist(0U, 15U);
+    std::uniform_int_distribution<int> value_dist(-1000, 1000);
+    return sample{
+        rdk::safe_unsigned<0U, 15U>{static_cast<uint8_t>(channel_dist(rng))}
+      , rdk::safe_signed<-1000, 1000>{static_cast<int16_t>(value_dist(rng))}
+      , rdk::safe_unsigned<0U, 1U>{static_cast<uint8_t>(channel_dist(rng) & 1U)}};
+  }
+}
+
+template<>
+struct rdk::packable_fields<sample> : rdk::packed_fields<&sample::channel, &sample::value, &sample::valid>
+{
+};
+
+template<>
+struct rdk::packable_fields<record> : rdk::packed_fields<&record::id, &record::first, &record::second>
+{
+};
+
+TEST(PackedStruct, Layout)
+{
+  using traits = rdk::packable_traits<sample>;
+  static_assert(rdk::is_packable_v<sample>, "registered structs shall be packable");
+  static_assert(!rdk::is_packable_v<unregistered>, "structs shall only be packable once registered");
+  static_assert(traits::packed_size == 16U, "members shall be packed densely");
+  static_assert(traits::offset<1> == 4U, "members shall be stored back to back");
+  static_assert(traits::offset<2> == 15U, "members shall be stored back to back");
+
+  constexpr auto packed = traits::pack(sample{rdk::safe_unsigned<0U, 15U>{uint8_t{3U}}, rdk::safe_signed<-1000, 1000>{int16_t{-1000}}, rdk::safe_unsigned<0U, 1U>{uint8_t{1U}}});
+  static_assert(packed.extract(0U, 16U) == 0x8003U, "packing shall be constexpr");
+  static_assert(traits::unpack(packed).value == rdk::safe_signed<-1000, 1000>{int16_t{-1000}}, "unpacking shall be constexpr");
+
+  static_assert(rdk::packable_traits<record>::packed_size == 96U, "registered structs shall nest");
+  static_assert(rdk::is_packable_v<std::tuple<sample, record>>, "registered structs shall nest in tuples");
+}
+
+TEST(PackedStruct, RoundTrip)
+{
+  using traits = rdk::packable_traits<sample>;
+  std::vector<sample> values;
+  for(size_t i{}; i < 10000U; ++i)
+  {
+    values.push_back(RandomSample());
+    sample const &v = values.back();
+
+    // same as hand written shift / mask code
+    uint64_t const expected = static_cast<uint64_t>(static_cast<uint8_t>(v.channel))
+      | (static_cast<uint64_t>(static_cast<int16_t>(v.value) + 1000) << 4U)
+      | (static_cast<uint64_t>(static_cast<uint8_t>(v.valid)) << 15U);
+    auto const packed = traits::pack(v);
+    ASSERT_EQ(expected, packed.extract(0U, traits::packed_size));
+    ASSERT_TRUE(v == traits::unpack(packed));
+  }
+
+  rdk::packed_vector<sample> const packed(values.begin(), values.end());
+  ASSERT_EQ(values.size() * traits::packed_size / 64U, packed.word_count());
+  ASSERT_TRUE(std::equal(values.begin(), values.end(), packed.begin()));
+}
+
+TEST(PackedStruct, Nested)
+{
+  using traits = rdk::packable_traits<record>;
+  std::uniform_int_distribution<uint64_t> dist;
+  std::vector<record> values;
+  for(size_t i{}; i < 1000U; ++i)
+  {
+    values.push_back(record{rdk::safe_unsigned<0U, std::numeric_limits<uint64_t>::max()>{dist(rng)}, RandomSample(), RandomSample()});
+  }
+
+  std::vector<std::byte> buffer(1U + (((values.size() * traits::packed_size) + 7U) / 8U));
+  rdk::bit_writer writer(buffer.data(), buffer.size());
+  writer.write(0U, 3U);
+  for(auto const &v : values)
+  {
+    writer.write(v);
+  }
+  writer.flush();
+
+  rdk::bit_reader reader(buffer.data(), buffer.size());
+  ASSERT_EQ(0U, reader.read(3U));
+  for(size_t i{}; i < values.size(); ++i)
+  {
+    ASSERT_TRUE(values[i] == reader.read<record>());
+    ASSERT_TRUE(values[i] == rdk::unpack_from<record>(buffer.data(), 3U + (i * traits::packed_size)));
+    ASSERT_TRUE(values[i].second == rdk::unpack_from<sample>(buffer.data(), 3U + (i * traits::packed_size) + traits::offset<2>));
+  }
+}
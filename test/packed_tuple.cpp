@@ -0,0 +1,112 @@
+#include "bit_io.hpp"
+#include "packed_tuple.hpp"
+#include "packed_vector.hpp"
+#include "safe_int.hpp"
+
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace
+{
+  template<typename Tuple, size_t... Is>
+  Tuple RandomTuple(std::index_sequence<Is...>)
+  {
+    return Tuple{RandomValue<std::tuple_element_t<Is, Tuple>>()...};
+  }
+
+  template<typename... Ps>
+  void TestTuple()
+  {
+    using value_type = std::tuple<Ps...>;
+    using traits = rdk::packable_traits<value_type>;
+    static_assert(rdk::is_packable_v<value_type>, "tuples of packables shall be packable");
+    static_assert(traits::packed_size == (rdk::packable_traits<Ps>::packed_size + ...), "fields shall be packed densely");
+
+    std::vector<value_type> values;
+    for(size_t i{}; i < 1000U; ++i)
+    {
+      values.push_back(RandomTuple<value_type>(std::index_sequence_for<Ps...>{}));
+    }
+
+    // the packed record shall be the concatenation of its fields, as written by bit_writer
+    std::vector<std::byte> expected(((values.size() * traits::packed_size) + 7U) / 8U);
+    rdk::bit_writer writer(expected.data(), expected.size());
+    for(auto const &v : values)
+    {
+      std::apply([&](auto const &... fields) { (writer.write(fields), ...); }, v);
+    }
+    writer.flush();
+
+    std::vector<std::byte> buffer(expected.size());
+    rdk::bit_writer record_writer(buffer.data(), buffer.size());
+    for(auto const &v : values)
+    {
+      record_writer.write(v);
+    }
+    record_writer.flush();
+    ASSERT_TRUE(expected == buffer) << traits::packed_size;
+
+    for(size_t i{}; i < values.size(); ++i)
+    {
+      ASSERT_TRUE(values[i] == traits::unpack(traits::pack(values[i])));
+      ASSERT_TRUE(values[i] == rdk::unpack_from<value_type>(buffer.data(), i * traits::packed_size));
+    }
+
+    rdk::packed_vector<value_type> const packed(values.begin(), values.end());
+    ASSERT_TRUE(std::equal(values.begin(), values.end(), packed.begin()));
+  }
+}
+
+TEST(PackedTuple, Layout)
+{
+  using type = std::tuple<rdk::safe_unsigned<0U, 15U>, rdk::safe_signed<-8, 7>, rdk::safe_unsigned<1000U, 1001U>>;
+  using traits = rdk::packable_traits<type>;
+  static_assert(traits::packed_size == 9U, "fields shall be packed densely");
+  static_assert(traits::offset<0> == 0U, "first field shall be stored in the lowest bits");
+  static_assert(traits::offset<1> == 4U, "fields shall be stored back to back");
+  static_assert(traits::offset<2> == 8U, "fields shall be stored back to back");
+  static_assert(!rdk::is_packable_v<std::tuple<rdk::safe_unsigned<0U, 15U>, int>>, "tuples with non packable fields shall not be packable");
+
+  constexpr auto packed = traits::pack(type{5U, -8, 1001U});
+  static_assert(packed.extract(0U, 9U) == 0x105U, "packing shall be constexpr");
+  static_assert(std::get<1>(traits::unpack(packed)) == rdk::safe_signed<-8, 7>{-8}, "unpacking shall be constexpr");
+
+  using pair_type = std::pair<rdk::safe_signed<-1, 1>, rdk::safe_unsigned<0U, 255U>>;
+  static_assert(rdk::packable_traits<pair_type>::packed_size == 10U, "pairs shall be packed densely");
+  constexpr auto packed_pair = rdk::packable_traits<pair_type>::pack(pair_type{1, 200U});
+  static_assert(packed_pair.extract(0U, 10U) == ((200U << 2U) | 2U), "second shall follow first");
+}
+
+TEST(PackedTuple, RoundTrip)
+{
+  TestTuple<rdk::safe_unsigned<0U, 1U>>();
+  TestTuple<rdk::safe_unsigned<0U, 15U>, rdk::safe_signed<-8, 7>, rdk::safe_unsigned<3U, 100U>>();
+  TestTuple<rdk::safe_signed<-1, -1>, rdk::safe_signed<-100, 100>, rdk::safe_unsigned<0U, 255U>>();
+  // records wider than a word, with fields straddling word boundaries
+  TestTuple<rdk::safe_signed<-1000, 1000>, rdk::safe_unsigned<0U, std::numeric_limits<uint64_t>::max()>, rdk::safe_signed<-2000000000, 2000000000>>();
+  TestTuple<rdk::safe_signed<std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max()>, rdk::safe_unsigned<0U, 7U>, rdk::safe_unsigned<0U, std::numeric_limits<uint64_t>::max()>>();
+}
+
+TEST(PackedTuple, Nested)
+{
+  using inner = std::pair<rdk::safe_unsigned<0U, 3U>, rdk::safe_signed<std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max()>>;
+  using outer = std::tuple<rdk::safe_signed<-5, 5>, inner, std::tuple<>, inner>;
+  using traits = rdk::packable_traits<outer>;
+  static_assert(rdk::is_packable_v<outer>, "nested tuples shall be packable");
+  static_assert(traits::packed_size == (4U + 66U + 0U + 66U), "nested tuples shall be packed densely");
+  static_assert(traits::offset<3> == 70U, "nested tuples shall be stored back to back");
+
+  std::uniform_int_distribution<int64_t> dist;
+  for(size_t i{}; i < 10000U; ++i)
+  {
+    using first_type = rdk::safe_unsigned<0U, 3U>;
+    using second_type = rdk::safe_signed<std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max()>;
+    inner const a{first_type{static_cast<uint8_t>(i % 4U)}, second_type{dist(rng)}};
+    inner const b{first_type{static_cast<uint8_t>((i + 1U) % 4U)}, second_type{dist(rng)}};
+    outer const v{rdk::safe_signed<-5, 5>{static_cast<int8_t>(static_cast<int>(i % 11U) - 5)}, a, std::tuple<>{}, b};
+    auto const packed = traits::pack(v);
+    ASSERT_EQ(std::get<3>(v).second, rdk::packable_traits<inner>::unpack(packed.extract<66U>(70U)).second);
+    ASSERT_TRUE(v == traits::unpack(packed));
+  }
+}
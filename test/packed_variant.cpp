@@ -0,0 +1,115 @@
+#include "packed_tuple.hpp"
+#include "packed_variant.hpp"
+#include "safe_int.hpp"
+
+#include <stdexcept>
+#include <tuple>
+#include <variant>
+#include <vector>
+
+namespace
+{
+  template<typename T>
+  struct Random
+  {
+    static T Value()
+    {
+      // the extremes are the boundaries between alternatives
+      return RandomCorner<T>();
+    }
+  };
+
+  template<typename... Ps>
+  struct Random<std::tuple<Ps...>>
+  {
+    static std::tuple<Ps...> Value()
+    {
+      return std::tuple<Ps...>{Random<Ps>::Value()...};
+    }
+  };
+
+  template<typename Variant, size_t... Is>
+  Variant RandomVariant(std::index_sequence<Is...>)
+  {
+    using factory = Variant (*)();
+    factory const factories[] = {[]() { return Variant{std::in_place_index<Is>, Random<std::variant_alternative_t<Is, Variant>>::Value()}; }...};
+    return factories[rng() % sizeof...(Is)]();
+  }
+
+  template<typename... Ps>
+  struct Random<std::variant<Ps...>>
+  {
+    static std::variant<Ps...> Value()
+    {
+      return RandomVariant<std::variant<Ps...>>(std::index_sequence_for<Ps...>{});
+    }
+  };
+
+  template<typename Variant>
+  struct Random<rdk::disjoint_sum<Variant>>
+  {
+    static rdk::disjoint_sum<Variant> Value()
+    {
+      return Random<Variant>::Value();
+    }
+  };
+
+  template<typename T>
+  void TestVariant(size_t expected_size)
+  {
+    std::vector<T> values;
+    for(size_t i{}; i < 1000U; ++i)
+    {
+      values.push_back(Random<T>::Value());
+    }
+    TestRoundTrip(values, expected_size, 3U);
+  }
+
+  using small = rdk::safe_unsigned<0U, 9U>;
+  using medium = rdk::safe_unsigned<0U, 99U>;
+  using wide = rdk::safe_signed<std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max()>;
+  using record = std::tuple<rdk::safe_signed<-8, 7>, rdk::safe_unsigned<0U, 255U>>;
+}
+
+TEST(PackedVariant, Tagged)
+{
+  using type = std::variant<small, medium, record>;
+  using traits = rdk::packable_traits<type>;
+  static_assert(traits::tag_size == 2U, "three alternatives shall take a two bit tag");
+  static_assert(traits::packed_size == 14U, "alternatives shall be padded to the widest one");
+
+  constexpr auto packed = traits::pack(type{std::in_place_index<1>, medium{uint8_t{42U}}});
+  static_assert(packed.extract(0U, 14U) == ((42U << 2U) | 1U), "the tag shall be stored in the lowest bits");
+  static_assert(std::get<1>(traits::unpack(packed)) == medium{uint8_t{42U}}, "unpacking shall be constexpr");
+
+  // corrupt data may carry tags that don't name an alternative
+  static_assert(!noexcept(traits::unpack(packed)), "unused tags shall be rejected");
+  static_assert(noexcept(rdk::packable_traits<std::variant<small, medium>>::unpack(rdk::packable_traits<std::variant<small, medium>>::packed_type{})), "alternatives using every tag shall not be checked");
+  EXPECT_THROW(traits::unpack(traits::packed_type{(42U << 2U) | 3U}), std::domain_error);
+  std::byte buffer[3]{std::byte{0xFF}, std::byte{0xFF}, std::byte{0xFF}};
+  EXPECT_THROW(rdk::unpack_from<type>(buffer, 5U), std::domain_error);
+
+  TestVariant<type>(14U);
+  TestVariant<std::variant<small>>(4U);
+  TestVariant<std::variant<small, wide, rdk::safe_signed<-1, -1>, medium, record>>(3U + 64U);
+  TestVariant<std::variant<std::variant<small, medium>, record>>(1U + 12U);
+}
+
+TEST(PackedVariant, DisjointSum)
+{
+  using type = rdk::disjoint_sum<std::variant<medium, small>>;
+  using traits = rdk::packable_traits<type>;
+  // 100 + 10 codes
+  static_assert(traits::packed_size == 7U, "alternatives shall share a single code space");
+  static_assert(traits::code_base<1> == 100U, "alternatives shall follow each other");
+
+  constexpr auto packed = traits::pack(type{std::in_place_index<1>, small{uint8_t{9U}}});
+  static_assert(packed.extract(0U, 7U) == 109U, "alternatives shall be offset by their base");
+  static_assert(std::get<1>(traits::unpack(packed)) == small{uint8_t{9U}}, "unpacking shall be constexpr");
+
+  TestVariant<type>(7U);
+  TestVariant<rdk::disjoint_sum<std::variant<small>>>(4U);
+  // 256 * 16 + 10 + 1 + 100 codes
+  TestVariant<rdk::disjoint_sum<std::variant<record, small, rdk::safe_signed<-1, -1>, medium>>>(13U);
+  TestVariant<rdk::disjoint_sum<std::variant<rdk::safe_unsigned<0U, std::numeric_limits<uint64_t>::max() - 10U>, small>>>(64U);
+}
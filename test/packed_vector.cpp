@@ -0,0 +1,126 @@
+#include "packed_vector.hpp"
+#include "safe_int.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+TEST(PackedVector, Footprint)
+{
+  using type = rdk::safe_unsigned<0U, 1000U>;
+  static_assert(rdk::packed_vector<type>::element_bits == 10U, "elements shall use their packed size");
+
+  rdk::packed_vector<type> v;
+  v.reserve(1000000U);
+  EXPECT_GE(v.capacity(), 1000000U);
+  for(size_t i{}; i < 1000000U; ++i)
+  {
+    v.push_back(type{static_cast<uint16_t>(i % 1001U)});
+  }
+  EXPECT_EQ(1000000U, v.size());
+  EXPECT_EQ(((1000000U * 10U) + 63U) / 64U, v.word_count());
+  for(size_t i{}; i < v.size(); ++i)
+  {
+    ASSERT_EQ(i % 1001U, static_cast<uint16_t>(type(v[i]))) << i;
+  }
+}
+
+TEST(PackedVector, Modify)
+{
+  using type = rdk::safe_signed<-50, 50>;
+  constexpr size_t count = 10000U;
+  std::uniform_int_distribution<int> dist(-50, 50);
+  std::vector<type> reference;
+  rdk::packed_vector<type> v;
+  for(size_t i{}; i < count; ++i)
+  {
+    reference.emplace_back(static_cast<int8_t>(dist(rng)));
+    v.push_back(reference.back());
+  }
+
+  std::uniform_int_distribution<size_t> index_dist(0U, count - 1U);
+  for(size_t i{}; i < count; ++i)
+  {
+    size_t const index = index_dist(rng);
+    reference[index] = type{static_cast<int8_t>(dist(rng))};
+    v[index] = reference[index];
+  }
+  ASSERT_TRUE(std::equal(reference.begin(), reference.end(), v.begin(), v.end()));
+
+  // proxy assignment between elements
+  v[0] = v[count - 1U];
+  reference[0] = reference[count - 1U];
+  swap(v[1], v[2]);
+  std::swap(reference[1], reference[2]);
+  ASSERT_TRUE(std::equal(reference.begin(), reference.end(), v.cbegin(), v.cend()));
+  ASSERT_TRUE(std::equal(reference.rbegin(), reference.rend(), v.rbegin(), v.rend()));
+
+  // algorithms on proxy iterators
+  std::reverse(v.begin(), v.end());
+  std::reverse(reference.begin(), reference.end());
+  ASSERT_TRUE(std::equal(reference.begin(), reference.end(), v.begin(), v.end()));
+  EXPECT_EQ(static_cast<ptrdiff_t>(count), v.end() - v.begin());
+  EXPECT_EQ(reference[17], v.begin()[17]);
+  EXPECT_EQ(reference[17], *(v.cbegin() + 17));
+
+  // comparisons between elements
+  v[3] = v[4];
+  EXPECT_TRUE(v[3] == v[4]);
+  EXPECT_FALSE(v[3] != v[4]);
+  v[5] = type{static_cast<int8_t>(-50)};
+  v[6] = type{static_cast<int8_t>(50)};
+  EXPECT_TRUE(v[5] != v[6]);
+  EXPECT_FALSE(v[5] == v[6]);
+  rdk::packed_vector<type> const copy(v.begin(), v.end());
+  ASSERT_TRUE(std::equal(v.begin(), v.end(), copy.begin(), copy.end()));
+  ASSERT_TRUE(std::equal(v.begin(), v.end(), rdk::packed_vector<type>(v).begin()));
+  std::vector<type> values(v.begin(), v.end());
+  EXPECT_EQ(std::adjacent_find(values.begin(), values.end()) - values.begin(), std::adjacent_find(v.begin(), v.end()) - v.begin());
+  values.erase(std::unique(values.begin(), values.end()), values.end());
+  auto const last = std::unique(v.begin(), v.end());
+  ASSERT_TRUE(std::equal(values.begin(), values.end(), v.begin(), last));
+}
+
+TEST(PackedVector, Resize)
+{
+  using type = rdk::safe_unsigned<10U, 17U>;
+  rdk::packed_vector<type> v(100U, type{17U});
+  rdk::packed_vector<type> w;
+  for(size_t i{}; i < 50U; ++i)
+  {
+    w.push_back(type{17U});
+  }
+  EXPECT_NE(v, w);
+  v.resize(50U, type{10U});
+  EXPECT_EQ(v, w);
+  v.pop_back();
+  w.resize(49U, type{10U});
+  EXPECT_EQ(v, w);
+  v.resize(60U, type{12U});
+  EXPECT_EQ(type{12U}, v.back());
+  EXPECT_EQ(type{17U}, v.front());
+  EXPECT_THROW(v.at(60U), std::out_of_range);
+  v.clear();
+  v.shrink_to_fit();
+  EXPECT_TRUE(v.empty());
+  EXPECT_EQ(0U, v.word_count());
+}
+
+TEST(PackedVector, WideElements)
+{
+  using type = rdk::safe_signed<std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max()>;
+  std::uniform_int_distribution<int64_t> dist(std::numeric_limits<int64_t>::min());
+  std::vector<type> reference;
+  for(size_t i{}; i < 1000U; ++i)
+  {
+    reference.emplace_back(dist(rng));
+  }
+  rdk::packed_vector<type> v(reference.begin(), reference.end());
+  ASSERT_TRUE(std::equal(reference.begin(), reference.end(), v.begin(), v.end()));
+
+  // empty ranges don't need any storage
+  rdk::packed_vector<rdk::safe_signed<3, 3>> empty(1000U, rdk::safe_signed<3, 3>{3});
+  EXPECT_EQ(1000U, empty.size());
+  EXPECT_EQ(0U, empty.word_count());
+  EXPECT_EQ(3, static_cast<int8_t>(rdk::safe_signed<3, 3>(empty[999])));
+}
@@ -1,6 +1,10 @@
+#include "bit_io.hpp"
 #include "packer.hpp"
 #include "safe_int.hpp"
 
+#include <algorithm>
+#include <vector>
+
 TEST(packer, SafeInt_Signed)
 {
   constexpr intmax_t min = std::numeric_limits<int64_t>::min();
@@ -34,3 +38,178 @@ TEST(packer, SafeInt_Unsigned)
     ASSERT_EQ(v, unpacked) << traits::packed_size << ',' << static_cast<type::value_type>(v);
   }
 }
+
+TEST(packer, Bitstream_ExtractInsert)
+{
+  // mirror every insert in a plain bit array and compare the results of random accesses
+  constexpr size_t bits = 200U;
+  rdk::bitstream<bits> stream;
+  bool reference[bits]{};
+  std::uniform_int_distribution<size_t> width_dist(0U, 64U);
+  std::uniform_int_distribution<uint64_t> value_dist;
+  for(size_t i{}; i < 100000U; ++i)
+  {
+    size_t const width = width_dist(rng);
+    size_t const offset = std::uniform_int_distribution<size_t>(0U, bits - width)(rng);
+    uint64_t const value = value_dist(rng);
+    stream.insert(offset, width, value);
+    for(size_t j{}; j < width; ++j)
+    {
+      reference[offset + j] = (0U != ((value >> j) & 1U));
+    }
+
+    size_t const read_width = width_dist(rng);
+    size_t const read_offset = std::uniform_int_distribution<size_t>(0U, bits - read_width)(rng);
+    uint64_t expected{};
+    for(size_t j{}; j < read_width; ++j)
+    {
+      expected |= static_cast<uint64_t>(reference[read_offset + j]) << j;
+    }
+    ASSERT_EQ(expected, stream.extract(read_offset, read_width)) << read_offset << ',' << read_width;
+  }
+  // bits past the end must stay clear
+  ASSERT_EQ(0U, stream.word(rdk::bitstream<bits>::word_count - 1U) >> (bits % 64U));
+}
+
+TEST(packer, Bitstream_Constexpr)
+{
+  constexpr auto stream = []
+  {
+    rdk::bitstream<100> s;
+    s.insert(60U, 8U, 0xA5U);
+    s.insert(3U, 5U, 0x1FU);
+    return s;
+  }();
+  static_assert(stream.extract(60U, 8U) == 0xA5U, "bitstream shall be usable in constant expressions");
+  static_assert(stream.extract(3U, 5U) == 0x1FU, "bitstream shall be usable in constant expressions");
+  static_assert(stream.word(0U) == ((uint64_t{0x5U} << 60U) | (uint64_t{0x1FU} << 3U)), "bitstream words shall be little endian");
+  static_assert(stream.word(1U) == 0xAU, "bitstream words shall be little endian");
+
+  using traits = rdk::packable_traits<rdk::safe_signed<-5, 1000>>;
+  static_assert(traits::packed_size == 10U, "SafeInt packed size shall be minimal");
+  static_assert(traits::pack(rdk::safe_signed<-5, 1000>{-5}).word(0U) == 0U, "SafeInt shall be packed relative to its minimum");
+  static_assert(static_cast<int16_t>(traits::unpack(rdk::bitstream<10>{1005U})) == 1000, "SafeInt shall be unpacked relative to its minimum");
+}
+
+TEST(packer, SafeInt_Small)
+{
+  using type = rdk::safe_signed<-100, 27>;
+  using traits = rdk::packable_traits<type>;
+  static_assert(traits::packed_size == 7U, "SafeInt packed size shall be minimal");
+  for(int v = -100; v <= 27; ++v)
+  {
+    type const value{static_cast<type::value_type>(v)};
+    ASSERT_EQ(value, traits::unpack(traits::pack(value))) << v;
+  }
+}
+
+TEST(packer, Bitstream_Wide)
+{
+  // multi word ranges shall behave like a sequence of word sized accesses
+  constexpr size_t bits = 300U;
+  rdk::bitstream<bits> stream;
+  std::uniform_int_distribution<uint64_t> value_dist;
+  for(size_t i{}; i < rdk::bitstream<bits>::word_count; ++i)
+  {
+    stream.insert(i * 64U, std::min<size_t>(64U, bits - (i * 64U)), value_dist(rng));
+  }
+
+  for(size_t i{}; i < 10000U; ++i)
+  {
+    size_t const offset = std::uniform_int_distribution<size_t>(0U, bits - 150U)(rng);
+    auto const wide = stream.extract<150>(offset);
+    ASSERT_EQ(stream.extract(offset, 64U), wide.word(0U)) << offset;
+    ASSERT_EQ(stream.extract(offset + 64U, 64U), wide.word(1U)) << offset;
+    ASSERT_EQ(stream.extract(offset + 128U, 22U), wide.word(2U)) << offset;
+
+    auto copy = stream;
+    copy.insert(offset, rdk::bitstream<150>{});
+    copy.insert(offset, wide);
+    ASSERT_EQ(stream, copy) << offset;
+  }
+}
+
+TEST(packer, SafeInt_WideRecord)
+{
+  // 96 bit key built from a 64 bit and a 32 bit field
+  using hi_type = rdk::safe_unsigned<0U, std::numeric_limits<uint64_t>::max()>;
+  using lo_type = rdk::safe_signed<std::numeric_limits<int32_t>::min(), std::numeric_limits<int32_t>::max()>;
+  using hi_traits = rdk::packable_traits<hi_type>;
+  using lo_traits = rdk::packable_traits<lo_type>;
+  constexpr size_t record_size = lo_traits::packed_size + hi_traits::packed_size;
+  static_assert(record_size == 96U, "fields shall pack into 96 bits");
+
+  std::uniform_int_distribution<uint64_t> hi_dist;
+  std::uniform_int_distribution<int32_t> lo_dist(std::numeric_limits<int32_t>::min());
+  for(size_t i{}; i < 100000U; ++i)
+  {
+    hi_type const hi{hi_dist(rng)};
+    lo_type const lo{lo_dist(rng)};
+
+    rdk::bitstream<record_size> record;
+    record.insert(0U, lo_traits::pack(lo));
+    record.insert(lo_traits::packed_size, hi_traits::pack(hi));
+
+    ASSERT_EQ(lo, lo_traits::unpack(record.extract<lo_traits::packed_size>(0U)));
+    ASSERT_EQ(hi, hi_traits::unpack(record.extract<hi_traits::packed_size>(lo_traits::packed_size)));
+  }
+}
+
+namespace
+{
+  template<typename T>
+  void TestPackInto(typename T::value_type min, typename T::value_type max)
+  {
+    using traits = rdk::packable_traits<T>;
+    constexpr size_t count = 1000U;
+    std::vector<T> values;
+    for(size_t i{}; i < count; ++i)
+    {
+      values.emplace_back(RandomInteger(min, max));
+    }
+
+    // values at offset 1 + i * packed_size shall match a stream written sequentially
+    // the buffer is sized exactly, so the last value ends in its last byte
+    size_t const bits = 1U + (count * traits::packed_size);
+    std::vector<std::byte> expected((bits + 7U) / 8U);
+    rdk::bit_writer writer(expected.data(), expected.size());
+    writer.write(0x1U, 1U);
+    for(auto const &v : values)
+    {
+      writer.write(v);
+    }
+    writer.flush();
+
+    std::vector<std::byte> buffer(expected.size(), std::byte{0xFF});
+    buffer[0] = std::byte{0x01};
+    for(size_t i{}; i < count; ++i)
+    {
+      rdk::pack_into(buffer.data(), 1U + (i * traits::packed_size), values[i]);
+    }
+    // pack in reverse order a second time to make sure neighbouring bits are preserved
+    for(size_t i = count; i-- > 0U;)
+    {
+      traits::pack_into(buffer.data(), 1U + (i * traits::packed_size), values[i]);
+    }
+    if(0U != (bits % 8U))
+    {
+      buffer.back() &= static_cast<std::byte>((1U << (bits % 8U)) - 1U);
+    }
+    ASSERT_TRUE(expected == buffer) << traits::packed_size;
+
+    for(size_t i{}; i < count; ++i)
+    {
+      ASSERT_EQ(values[i], rdk::unpack_from<T>(buffer.data(), 1U + (i * traits::packed_size))) << traits::packed_size << ',' << i;
+    }
+  }
+}
+
+TEST(packer, SafeInt_PackInto)
+{
+  TestPackInto<rdk::safe_unsigned<0U, 1U>>(0U, 1U);
+  TestPackInto<rdk::safe_signed<-5, 1000>>(-5, 1000);
+  TestPackInto<rdk::safe_unsigned<7U, 0xFFFFFU>>(7U, 0xFFFFFU);
+  TestPackInto<rdk::safe_signed<-(int64_t{1} << 56), (int64_t{1} << 56)>>(-(int64_t{1} << 56), (int64_t{1} << 56));
+  TestPackInto<rdk::safe_unsigned<0U, std::numeric_limits<uint64_t>::max()>>(0U, std::numeric_limits<uint64_t>::max());
+  TestPackInto<rdk::safe_signed<std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max()>>(std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max());
+}
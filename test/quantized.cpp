@@ -0,0 +1,144 @@
+#include "packed_bulk.hpp"
+#include "packed_optional.hpp"
+#include "packed_vector.hpp"
+#include "quantized.hpp"
+
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <ratio>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+  using temperature = rdk::quantized<float, std::ratio<-50>, std::ratio<150>, std::centi>;
+
+  template<typename Q>
+  std::vector<typename Q::value_type> RandomValues(size_t count)
+  {
+    std::uniform_real_distribution<typename Q::value_type> dist(Q::min_value, Q::max_value);
+    std::vector<typename Q::value_type> res{Q::min_value, Q::max_value};
+    for(size_t i{}; i < count; ++i)
+    {
+      res.push_back(dist(rng));
+    }
+    return res;
+  }
+
+  template<typename Q>
+  void TestBulk()
+  {
+    using code_type = typename Q::code_type;
+    using value_type = typename Q::value_type;
+    // half a step, plus rounding errors of a few ulps of the largest magnitude
+    value_type const tolerance = (Q::resolution / 2) + (4 * std::numeric_limits<value_type>::epsilon() * std::max(std::abs(Q::min_value), std::abs(Q::max_value)));
+    // all tail lengths of the vector kernels
+    for(size_t n : {size_t{0U}, size_t{1U}, size_t{7U}, size_t{8U}, size_t{9U}, size_t{17U}, size_t{1000U}})
+    {
+      auto const values = RandomValues<Q>(n);
+      std::vector<code_type> codes(values.size(), std::numeric_limits<code_type>::max());
+      rdk::quantize_bulk<Q>(values.data(), values.size(), codes.data());
+
+      std::vector<typename Q::value_type> restored(values.size());
+      rdk::dequantize_bulk<Q>(codes.data(), codes.size(), restored.data());
+      for(size_t i{}; i < values.size(); ++i)
+      {
+        Q const expected{values[i]};
+        ASSERT_EQ(expected.code(), codes[i]) << values[i];
+        ASSERT_EQ(static_cast<typename Q::value_type>(expected), restored[i]);
+        ASSERT_LE(std::abs(values[i] - restored[i]), tolerance) << values[i];
+      }
+
+      rdk::detail::quantize_bulk_scalar<Q>(values.data(), values.size(), codes.data());
+      rdk::detail::dequantize_bulk_scalar<Q>(codes.data(), codes.size(), restored.data());
+      for(size_t i{}; i < values.size(); ++i)
+      {
+        ASSERT_EQ(Q{values[i]}.code(), codes[i]) << values[i];
+        ASSERT_EQ(static_cast<typename Q::value_type>(Q{values[i]}), restored[i]);
+      }
+    }
+  }
+}
+
+TEST(Quantized, Construction)
+{
+  static_assert(temperature::max_code == 20000U, "codes shall span the range in steps of the resolution");
+  static_assert(std::is_same_v<temperature::code_type, rdk::safe_unsigned<0U, 20000U>>, "codes shall be stored in the narrowest safe integer");
+
+  EXPECT_EQ(static_cast<uint16_t>(temperature{-50.0F}.code()), 0U);
+  EXPECT_EQ(static_cast<uint16_t>(temperature{150.0F}.code()), 20000U);
+  EXPECT_EQ(static_cast<uint16_t>(temperature{0.0F}.code()), 5000U);
+  EXPECT_EQ(static_cast<uint16_t>(temperature{21.374F}.code()), 7137U);
+  EXPECT_EQ(static_cast<uint16_t>(temperature{21.376F}.code()), 7138U);
+  EXPECT_FLOAT_EQ(static_cast<float>(temperature{21.376F}), 21.38F);
+  EXPECT_EQ(temperature{temperature::code_type{7138U}}, temperature{21.38F});
+  EXPECT_TRUE(temperature{-1.0F} < temperature{1.0F});
+  EXPECT_TRUE(temperature{-1.0F} != temperature{1.0F});
+
+  EXPECT_THROW(temperature{-50.01F}, std::domain_error);
+  EXPECT_THROW(temperature{150.01F}, std::domain_error);
+  EXPECT_THROW(temperature{std::numeric_limits<float>::quiet_NaN()}, std::domain_error);
+  EXPECT_THROW(temperature{std::numeric_limits<float>::infinity()}, std::domain_error);
+
+  // resolutions that don't divide the range end at the code Max rounds to
+  using coarse = rdk::quantized<double, std::ratio<0>, std::ratio<10>, std::ratio<3>>;
+  static_assert(coarse::max_code == 3U, "codes shall end at the one Max rounds to");
+  static_assert(coarse::decode(coarse::max_code) <= 10.0, "the top code shall not exceed Max when Max rounds down");
+  EXPECT_EQ(static_cast<uint8_t>(coarse{10.0}.code()), 3U);
+  EXPECT_EQ(static_cast<uint8_t>(coarse{9.9}.code()), 3U);
+  EXPECT_EQ(static_cast<uint8_t>(coarse{4.4}.code()), 1U);
+  EXPECT_EQ(static_cast<uint8_t>(coarse{4.6}.code()), 2U);
+
+  // half steps round up, the top code is then at most half a resolution above Max
+  using half = rdk::quantized<double, std::ratio<0>, std::ratio<7>, std::ratio<2>>;
+  static_assert(half::max_code == 4U, "codes shall end at the one Max rounds to");
+  EXPECT_EQ(static_cast<uint8_t>(half{7.0}.code()), 4U);
+  EXPECT_LE(half::decode(half::max_code), 7.0 + (half::resolution / 2.0));
+}
+
+TEST(Quantized, Packing)
+{
+  using traits = rdk::packable_traits<temperature>;
+  static_assert(rdk::is_packable_v<temperature>, "quantized values shall be packable");
+  static_assert(traits::packed_size == 15U, "quantized values shall be packed as their code");
+  static_assert(rdk::packable_traits<std::optional<temperature>>::packed_size == 15U, "optionals shall use the code's niche");
+
+  auto const values = RandomValues<temperature>(1000U);
+  std::vector<temperature> quantized;
+  for(float v : values)
+  {
+    quantized.emplace_back(v);
+  }
+  rdk::packed_vector<temperature> const packed(quantized.begin(), quantized.end());
+  ASSERT_EQ(packed.size(), quantized.size());
+  ASSERT_TRUE(std::equal(quantized.begin(), quantized.end(), packed.begin()));
+  for(auto const &v : quantized)
+  {
+    ASSERT_EQ(v, traits::unpack(traits::pack(v)));
+  }
+
+  // a float column becomes a 15 bit packed column
+  std::vector<temperature::code_type> codes(values.size(), temperature::code_type{0U});
+  rdk::quantize_bulk<temperature>(values.data(), values.size(), codes.data());
+  std::vector<uint64_t> words(((values.size() * traits::packed_size) + 63U) / 64U);
+  rdk::pack_bulk(codes.data(), codes.size(), words.data());
+  for(size_t i{}; i < quantized.size(); ++i)
+  {
+    ASSERT_EQ(quantized[i], rdk::unpack_from<temperature>(reinterpret_cast<std::byte const *>(words.data()), i * traits::packed_size));
+  }
+}
+
+TEST(Quantized, Bulk)
+{
+  TestBulk<temperature>();
+  TestBulk<rdk::quantized<float, std::ratio<0>, std::ratio<1>, std::ratio<1, 200>>>();
+  TestBulk<rdk::quantized<float, std::ratio<-1000>, std::ratio<1000>, std::milli>>();
+  TestBulk<rdk::quantized<double, std::ratio<-1>, std::ratio<1>, std::micro>>();
+
+  std::vector<float> values(100U, 0.0F);
+  values[97] = 200.0F;
+  std::vector<temperature::code_type> codes(values.size(), temperature::code_type{1U});
+  EXPECT_THROW(rdk::quantize_bulk<temperature>(values.data(), values.size(), codes.data()), std::domain_error);
+  EXPECT_TRUE(std::all_of(codes.begin(), codes.end(), [](auto c) { return c == temperature::code_type{1U}; }));
+}
@@ -0,0 +1,92 @@
+#include "safe_expr.hpp"
+
+#include <vector>
+
+namespace
+{
+  template<typename S>
+  intmax_t Value(S v)
+  {
+    return static_cast<intmax_t>(static_cast<typename S::value_type>(v));
+  }
+}
+
+TEST(SafeExpr, Ranges)
+{
+  using a_type = rdk::safe_unsigned<0U, 100U>;
+  using b_type = rdk::safe_signed<-50, 50>;
+
+  using mad = decltype(rdk::lazy(a_type{0U}) * a_type{0U} + b_type{0});
+  static_assert(std::is_same_v<mad::result_type, rdk::safe_signed<-50, 10050>>, "the result shall span the final interval");
+  static_assert(std::is_same_v<mad::compute_type, int16_t>, "intermediates shall be computed in the narrowest native type");
+
+  // unsigned operands mix with signed intermediates without widening
+  using mixed = decltype(rdk::lazy(a_type{0U}) - a_type{0U} + a_type{0U});
+  static_assert(std::is_same_v<mixed::result_type, rdk::safe_signed<-100, 200>>, "the result shall span the final interval");
+  static_assert(std::is_same_v<mixed::compute_type, int16_t>, "negative intermediates shall be computed in signed types");
+
+  using non_negative = decltype(rdk::lazy(a_type{0U}) + a_type{0U} + a_type{0U});
+  static_assert(std::is_same_v<non_negative::result_type, rdk::safe_unsigned<0U, 300U>>, "non-negative results shall be unsigned");
+  static_assert(std::is_same_v<non_negative::compute_type, uint16_t>, "non-negative intermediates shall be computed in unsigned types");
+
+  // the compute type covers intermediates wider than the result
+  using shrinking = decltype((rdk::lazy(a_type{0U}) * a_type{0U}) - (rdk::lazy(a_type{0U}) * a_type{0U}) + b_type{0});
+  static_assert(std::is_same_v<shrinking::compute_type, int16_t>, "intermediates shall fit into the compute type");
+  using negated = decltype(-rdk::lazy(b_type{0}) * a_type{0U});
+  static_assert(std::is_same_v<negated::result_type, rdk::safe_signed<-5000, 5000>>, "negation shall mirror the interval");
+
+  constexpr auto v = rdk::eval(rdk::lazy(a_type{7U}) * a_type{3U} - b_type{-50});
+  static_assert(v == rdk::safe_signed<-50, 10050>{71}, "evaluation shall be constexpr");
+}
+
+TEST(SafeExpr, Scalar)
+{
+  using a_type = rdk::safe_unsigned<0U, 255U>;
+  using b_type = rdk::safe_signed<-1000, 1000>;
+  using c_type = rdk::safe_signed<-2000000000, 2000000000>;
+  for(size_t i{}; i < 10000U; ++i)
+  {
+    auto const a = RandomValue<a_type>();
+    auto const b = RandomValue<b_type>();
+    auto const c = RandomValue<c_type>();
+
+    auto const r0 = rdk::eval(rdk::lazy(a) * b - a + b);
+    ASSERT_EQ((Value(a) * Value(b)) - Value(a) + Value(b), Value(r0));
+    ASSERT_TRUE(r0 == (a * b) - a + b) << "expressions shall match eager evaluation";
+
+    auto const r1 = rdk::eval(c * rdk::lazy(b) - (a * -rdk::lazy(c)));
+    ASSERT_EQ((Value(c) * Value(b)) + (Value(a) * Value(c)), Value(r1));
+
+    auto const r2 = rdk::eval(a - rdk::lazy(a));
+    static_assert(std::is_same_v<decltype(r2), rdk::safe_signed<-255, 255> const>, "the interval shall not depend on values");
+    ASSERT_EQ(0, Value(r2));
+  }
+}
+
+TEST(SafeExpr, Arrays)
+{
+  using a_type = rdk::safe_unsigned<0U, 200U>;
+  using b_type = rdk::safe_signed<-100, 100>;
+  constexpr size_t n = 1003U;
+
+  std::vector<a_type> a;
+  std::vector<b_type> b;
+  for(size_t i{}; i < n; ++i)
+  {
+    a.push_back(RandomValue<a_type>());
+    b.push_back(RandomValue<b_type>());
+  }
+
+  auto const bias = b_type{-7};
+  auto const e = rdk::lazy_each(a.data()) * rdk::lazy_each(b.data()) + bias;
+  using expr_type = std::remove_const_t<decltype(e)>;
+  static_assert(expr_type::elementwise, "array expressions shall be evaluated per element");
+  static_assert(std::is_same_v<expr_type::compute_type, int16_t>, "array expressions shall use narrow lanes");
+
+  std::vector<expr_type::result_type> out(n, expr_type::result_type{0});
+  rdk::eval_each(e, n, out.data());
+  for(size_t i{}; i < n; ++i)
+  {
+    ASSERT_EQ((Value(a[i]) * Value(b[i])) - 7, Value(out[i])) << i;
+  }
+}
@@ -0,0 +1,138 @@
+#include "bit_io.hpp"
+#include "packed_vector.hpp"
+#include "safe_fixed.hpp"
+
+#include <cmath>
+#include <vector>
+
+namespace
+{
+  /// uniformly distributed over the whole raw range
+  template<typename X>
+  X RandomFixed()
+  {
+    using value_type = typename X::value_type;
+    return X{RandomInteger(static_cast<value_type>(std::numeric_limits<typename X::raw_type>::min()), static_cast<value_type>(std::numeric_limits<typename X::raw_type>::max()))};
+  }
+
+  template<typename X>
+  long double Value(X v)
+  {
+    return static_cast<long double>(v);
+  }
+
+  template<typename X>
+  constexpr long double Min()
+  {
+    return static_cast<long double>(static_cast<typename X::value_type>(std::numeric_limits<typename X::raw_type>::min())) / static_cast<long double>(uintmax_t{1U} << X::fraction_bits);
+  }
+
+  template<typename X>
+  constexpr long double Max()
+  {
+    return static_cast<long double>(static_cast<typename X::value_type>(std::numeric_limits<typename X::raw_type>::max())) / static_cast<long double>(uintmax_t{1U} << X::fraction_bits);
+  }
+
+  /// checks that results are exact and in the result's range
+  template<typename A, typename B>
+  void TestArithmetic()
+  {
+    for(size_t i{}; i < 10000U; ++i)
+    {
+      auto const a = RandomFixed<A>();
+      auto const b = RandomFixed<B>();
+
+      auto const sum = a + b;
+      using sum_type = std::remove_const_t<decltype(sum)>;
+      static_assert(sum_type::fraction_bits == std::max(A::fraction_bits, B::fraction_bits), "sums shall keep the finer resolution");
+      ASSERT_EQ(Value(a) + Value(b), Value(sum));
+      ASSERT_EQ(Min<A>() + Min<B>(), Min<sum_type>());
+      ASSERT_EQ(Max<A>() + Max<B>(), Max<sum_type>());
+
+      auto const diff = a - b;
+      using diff_type = std::remove_const_t<decltype(diff)>;
+      ASSERT_EQ(Value(a) - Value(b), Value(diff));
+      ASSERT_EQ(Min<A>() - Max<B>(), Min<diff_type>());
+      ASSERT_EQ(Max<A>() - Min<B>(), Max<diff_type>());
+
+      auto const product = a * b;
+      using product_type = std::remove_const_t<decltype(product)>;
+      static_assert(product_type::fraction_bits == (A::fraction_bits + B::fraction_bits), "products shall be exact");
+      ASSERT_EQ(Value(a) * Value(b), Value(product));
+      ASSERT_LE(Min<product_type>(), Value(product));
+      ASSERT_GE(Max<product_type>(), Value(product));
+
+      ASSERT_EQ(Value(a) < Value(b), a < b);
+      ASSERT_EQ(Value(a) == Value(b), a == b);
+      ASSERT_EQ(Value(a) > Value(b), a > b);
+      ASSERT_EQ(Value(a) <= Value(b), a <= b);
+      ASSERT_EQ(Value(a) >= Value(b), a >= b);
+      ASSERT_TRUE((a <= a) && (a >= a) && !(a > a));
+    }
+  }
+}
+
+TEST(SafeFixed, Construction)
+{
+  using q14 = rdk::safe_fixed_signed<-(1 << 14), (1 << 14), 14>;
+  static_assert(std::is_same_v<q14::value_type, int16_t>, "storage shall be deduced from the raw range");
+  EXPECT_EQ(static_cast<double>(q14{8192}), 0.5);
+  EXPECT_EQ(static_cast<double>(q14{-16384}), -1.0);
+  EXPECT_THROW(q14{16385}, std::domain_error);
+  EXPECT_EQ(static_cast<int16_t>(q14{123}.raw()), 123);
+}
+
+TEST(SafeFixed, Ranges)
+{
+  using q14 = rdk::safe_fixed_signed<-(1 << 14), (1 << 14), 14>;
+  using q8 = rdk::safe_fixed_unsigned<0U, 1000U, 8>;
+
+  // [-1, 1] * [-1, 1] stays in [-1, 1], with twice the fraction bits
+  using square = decltype(q14{0} * q14{0});
+  static_assert(square::fraction_bits == 28U, "products shall add fraction bits");
+  static_assert(std::is_same_v<square::raw_type, rdk::safe_signed<-(1 << 28), (1 << 28)>>, "products shall span the corner products");
+  using rescaled = decltype(rdk::rescale<14>(q14{0} * q14{0}));
+  static_assert(std::is_same_v<rescaled, q14>, "rescaling shall shrink the range back");
+
+  using mixed = decltype(q14{0} + q8{0U});
+  static_assert(mixed::fraction_bits == 14U, "sums shall align fraction bits");
+  static_assert(std::is_same_v<mixed::raw_type, rdk::safe_signed<-(1 << 14), (1 << 14) + (1000 << 6)>>, "sums shall align ranges");
+
+  using unsigned_product = decltype(q8{0U} * q8{0U});
+  static_assert(std::is_same_v<unsigned_product::raw_type, rdk::safe_unsigned<0U, 1000000U>>, "unsigned products shall stay unsigned");
+
+  constexpr auto half = q14{8192};
+  constexpr auto quarter = rdk::rescale<14>(half * half);
+  static_assert(quarter.raw() == rdk::safe_signed<-16384, 16384>{4096}, "arithmetic shall be constexpr");
+
+  // rounding towards negative infinity
+  EXPECT_EQ(static_cast<double>(rdk::rescale<0>(q14{-1})), -1.0);
+  EXPECT_EQ(static_cast<double>(rdk::rescale<0>(q14{16383})), 0.0);
+  EXPECT_EQ(static_cast<double>(rdk::rescale<20>(q14{-3})), -3.0 / 16384.0);
+}
+
+TEST(SafeFixed, Arithmetic)
+{
+  TestArithmetic<rdk::safe_fixed_signed<-(1 << 14), (1 << 14), 14>, rdk::safe_fixed_signed<-(1 << 14), (1 << 14), 14>>();
+  TestArithmetic<rdk::safe_fixed_signed<-(1 << 14), (1 << 14), 14>, rdk::safe_fixed_unsigned<0U, 1000U, 8>>();
+  TestArithmetic<rdk::safe_fixed_unsigned<0U, 1000U, 8>, rdk::safe_fixed_signed<-100, 7, 2>>();
+  TestArithmetic<rdk::safe_fixed_unsigned<10U, 1000U, 3>, rdk::safe_fixed_unsigned<0U, 100000U, 0>>();
+  TestArithmetic<rdk::safe_fixed_signed<-2000000000, 2000000000, 31>, rdk::safe_fixed_signed<-3, -1, 1>>();
+}
+
+TEST(SafeFixed, Packing)
+{
+  using type = rdk::safe_fixed_signed<-1000, 1000, 4>;
+  using traits = rdk::packable_traits<type>;
+  static_assert(rdk::is_packable_v<type>, "fixed point numbers shall be packable");
+  static_assert(traits::packed_size == 11U, "fixed point numbers shall be packed as their raw value");
+
+  std::vector<type> values;
+  for(size_t i{}; i < 1000U; ++i)
+  {
+    values.push_back(RandomFixed<type>());
+    ASSERT_EQ(values.back(), traits::unpack(traits::pack(values.back())));
+  }
+  rdk::packed_vector<type> const packed(values.begin(), values.end());
+  ASSERT_TRUE(std::equal(values.begin(), values.end(), packed.begin()));
+}
@@ -0,0 +1,19 @@
+#include "safe_int.hpp"
+
+#include <limits>
+
+TEST(SafeInt, MulOverflow)
+{
+#ifdef RDK_HAS_INT128
+  // the product range exceeds 128 bit integers
+  using wide = rdk::safe_signed<-(rdk::detail::intwide_t{1} << 70), rdk::detail::intwide_t{1} << 70>;
+  wide v1{rdk::detail::int128_t{2}};
+  rdk::safe_signed<std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max()> v2{3};
+#else
+  // the product range exceeds int64_t
+  rdk::safe_signed<0, std::numeric_limits<int32_t>::max()> v1{2};
+  rdk::safe_signed<std::numeric_limits<int32_t>::min(), 0x7FFFFFFFFF> v2{3};
+#endif
+  auto r = v1 * v2;
+  (void)r;
+}
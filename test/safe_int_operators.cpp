@@ -1,6 +1,8 @@
 #include "safe_int.hpp"
 
+#include <algorithm>
 #include <type_traits>
+#include <utility>
 
 namespace
 {
@@ -75,9 +77,362 @@ TEST(SafeInt, Sub)
   auto r1 = v1 - v2;
   EXPECT_EQ(3 - -127, static_cast<decltype(r1)::value_type>(r1));
   auto r2 = v3 - v4;
+  static_assert(std::is_signed_v<decltype(r2)::value_type>, "differences that can be negative shall be signed");
   EXPECT_EQ(12 - 0x2000, static_cast<decltype(r2)::value_type>(r2));
+  auto r5 = v4 - v3;
+  static_assert(std::is_same_v<decltype(r5), rdk::safe_unsigned<0x1000 - 0x7F, 0x7FFF>>, "differences that can't be negative shall be unsigned");
+  EXPECT_EQ(0x2000 - 12, static_cast<decltype(r5)::value_type>(r5));
   auto r3 = v1 - v4;
   EXPECT_EQ(3 - 0x2000, static_cast<decltype(r3)::value_type>(r3));
   auto r4 = v3 - v2;
   EXPECT_EQ(12 - -127, static_cast<decltype(r4)::value_type>(r4));
 }
+
+TEST(SafeInt, Mul)
+{
+  rdk::safe_signed<0, 5> v1{3};
+  rdk::safe_signed<-0x8000, 0x7FFF> v2{-127};
+  rdk::safe_unsigned<0, 0x7F> v3{12};
+  rdk::safe_unsigned<0x1000, 0x7FFF> v4{0x2000};
+
+  auto r1 = v1 * v2;
+  static_assert(std::is_same_v<decltype(r1), rdk::safe_signed<-0x28000, 0x27FFB>>, "products shall span the corner products");
+  EXPECT_EQ(3 * -127, static_cast<decltype(r1)::value_type>(r1));
+  auto r2 = v3 * v4;
+  static_assert(std::is_same_v<decltype(r2), rdk::safe_unsigned<0, 0x7F * 0x7FFF>>, "unsigned products shall stay unsigned");
+  EXPECT_EQ(12U * 0x2000U, static_cast<decltype(r2)::value_type>(r2));
+  auto r3 = v2 * v2;
+  static_assert(std::is_same_v<decltype(r3), rdk::safe_signed<-0x8000 * 0x7FFF, 0x8000 * 0x8000>>, "the largest corner shall be the product of the minimums");
+  EXPECT_EQ(127 * 127, static_cast<decltype(r3)::value_type>(r3));
+  auto r4 = v3 * v2;
+  EXPECT_EQ(12 * -127, static_cast<decltype(r4)::value_type>(r4));
+
+  rdk::safe_signed<-3, -2> v5{-2};
+  auto r5 = v5 * v5;
+  static_assert(std::is_same_v<decltype(r5), rdk::safe_signed<4, 9>>, "products of negative ranges shall be positive");
+  EXPECT_EQ(4, static_cast<decltype(r5)::value_type>(r5));
+
+  constexpr auto big = rdk::safe_signed<std::numeric_limits<int32_t>::min(), std::numeric_limits<int32_t>::max()>{std::numeric_limits<int32_t>::min()};
+  constexpr auto r6 = big * big;
+  static_assert(std::is_same_v<decltype(r6)::value_type, int64_t>, "products shall widen as needed");
+  static_assert(static_cast<int64_t>(r6) == (int64_t{1} << 62), "multiplication shall be constexpr");
+
+  constexpr auto wide = rdk::safe_unsigned<0U, std::numeric_limits<uint32_t>::max()>{std::numeric_limits<uint32_t>::max()};
+  static_assert(static_cast<uint64_t>(wide * wide) == (uint64_t{std::numeric_limits<uint32_t>::max()} * std::numeric_limits<uint32_t>::max()), "unsigned products shall widen as needed");
+}
+
+namespace
+{
+  /// compares against native division for every pair of operands
+  template<typename T, typename U>
+  void TestDivision()
+  {
+    using lhs_type = typename T::value_type;
+    using rhs_type = typename U::value_type;
+    using quotient_type = decltype(std::declval<T>() / std::declval<U>());
+    using remainder_type = decltype(std::declval<T>() % std::declval<U>());
+    constexpr auto lmin = static_cast<intmax_t>(static_cast<lhs_type>(std::numeric_limits<T>::min()));
+    constexpr auto lmax = static_cast<intmax_t>(static_cast<lhs_type>(std::numeric_limits<T>::max()));
+    constexpr auto rmin = static_cast<intmax_t>(static_cast<rhs_type>(std::numeric_limits<U>::min()));
+    constexpr auto rmax = static_cast<intmax_t>(static_cast<rhs_type>(std::numeric_limits<U>::max()));
+
+    intmax_t qmin = std::numeric_limits<intmax_t>::max();
+    intmax_t qmax = std::numeric_limits<intmax_t>::min();
+    intmax_t rem_min = std::numeric_limits<intmax_t>::max();
+    intmax_t rem_max = std::numeric_limits<intmax_t>::min();
+    for(intmax_t a = lmin; a <= lmax; ++a)
+    {
+      for(intmax_t b = rmin; b <= rmax; ++b)
+      {
+        T const lhs{static_cast<lhs_type>(a)};
+        U const rhs{static_cast<rhs_type>(b)};
+        if(0 == b)
+        {
+          ASSERT_THROW(lhs / rhs, std::domain_error);
+          ASSERT_THROW(lhs % rhs, std::domain_error);
+          continue;
+        }
+        auto const q = lhs / rhs;
+        auto const r = lhs % rhs;
+        ASSERT_EQ(a / b, static_cast<intmax_t>(static_cast<typename quotient_type::value_type>(q))) << a << '/' << b;
+        ASSERT_EQ(a % b, static_cast<intmax_t>(static_cast<typename remainder_type::value_type>(r))) << a << '%' << b;
+        qmin = std::min(qmin, a / b);
+        qmax = std::max(qmax, a / b);
+        rem_min = std::min(rem_min, a % b);
+        rem_max = std::max(rem_max, a % b);
+      }
+    }
+
+    // quotient ranges are exact, remainder ranges sound
+    ASSERT_EQ(qmin, static_cast<intmax_t>(static_cast<typename quotient_type::value_type>(std::numeric_limits<quotient_type>::min())));
+    ASSERT_EQ(qmax, static_cast<intmax_t>(static_cast<typename quotient_type::value_type>(std::numeric_limits<quotient_type>::max())));
+    ASSERT_GE(rem_min, static_cast<intmax_t>(static_cast<typename remainder_type::value_type>(std::numeric_limits<remainder_type>::min())));
+    ASSERT_LE(rem_max, static_cast<intmax_t>(static_cast<typename remainder_type::value_type>(std::numeric_limits<remainder_type>::max())));
+  }
+}
+
+TEST(SafeInt, Div)
+{
+  TestDivision<rdk::safe_signed<-100, 100>, rdk::safe_signed<-7, 7>>();
+  TestDivision<rdk::safe_signed<-100, 100>, rdk::safe_signed<3, 7>>();
+  TestDivision<rdk::safe_signed<-100, -20>, rdk::safe_signed<-7, -3>>();
+  TestDivision<rdk::safe_signed<-128, 127>, rdk::safe_signed<-1, 1>>();
+  TestDivision<rdk::safe_signed<-128, 127>, rdk::safe_signed<-1, -1>>();
+  TestDivision<rdk::safe_unsigned<0U, 255U>, rdk::safe_signed<-3, 5>>();
+  TestDivision<rdk::safe_signed<-50, 50>, rdk::safe_unsigned<0U, 9U>>();
+  TestDivision<rdk::safe_unsigned<20U, 300U>, rdk::safe_unsigned<0U, 17U>>();
+  TestDivision<rdk::safe_unsigned<20U, 300U>, rdk::safe_unsigned<16U, 16U>>();
+
+  // -128 / -1 doesn't fit int8_t, so the quotient widens instead of checking
+  using narrow = decltype(rdk::safe_signed<-128, 127>{0} / rdk::safe_signed<-1, -1>{-1});
+  static_assert(std::is_same_v<narrow, rdk::safe_signed<-127, 128>>, "quotients shall widen to hold min / -1");
+
+  // checks only exist if the divisor range allows them
+  static_assert(noexcept(std::declval<rdk::safe_signed<-100, 100>>() / std::declval<rdk::safe_signed<1, 7>>()), "divisors excluding zero shall not be checked");
+  static_assert(!noexcept(std::declval<rdk::safe_signed<-100, 100>>() / std::declval<rdk::safe_signed<0, 7>>()), "divisors including zero shall be checked");
+  static_assert(noexcept(std::declval<rdk::safe_signed<-100, 100>>() % std::declval<rdk::safe_signed<-7, -1>>()), "divisors excluding zero shall not be checked");
+
+  // only min / -1 of intmax_t can't be represented at all
+  using wide = rdk::safe_signed<std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max()>;
+  using minus_one = rdk::safe_signed<-1, 1>;
+  static_assert(!noexcept(std::declval<wide>() / std::declval<rdk::safe_signed<-1, -1>>()), "min / -1 shall be checked");
+  static_assert(noexcept(std::declval<wide>() / std::declval<rdk::safe_signed<-3, -2>>()), "min / -1 shall only be checked if -1 is in range");
+  static_assert(noexcept(std::declval<rdk::safe_signed<std::numeric_limits<int64_t>::min() + 1, 0>>() / std::declval<rdk::safe_signed<-1, -1>>()), "min / -1 shall only be checked if min is in range");
+  EXPECT_THROW(wide{std::numeric_limits<int64_t>::min()} / minus_one{-1}, std::domain_error);
+  EXPECT_EQ(std::numeric_limits<int64_t>::max(), static_cast<int64_t>(wide{std::numeric_limits<int64_t>::min() + 1} / minus_one{-1}));
+  EXPECT_EQ(0, static_cast<int8_t>(wide{std::numeric_limits<int64_t>::min()} % minus_one{-1}));
+
+  constexpr auto q = rdk::safe_unsigned<0U, 1000U>{999U} / rdk::safe_unsigned<10U, 10U>{10U};
+  static_assert(std::is_same_v<decltype(q), rdk::safe_unsigned<0U, 100U> const>, "constant divisors shall narrow the range");
+  static_assert(static_cast<uint8_t>(q) == 99U, "division shall be constexpr");
+}
+
+namespace
+{
+  template<typename S>
+  constexpr intmax_t Min()
+  {
+    return static_cast<intmax_t>(static_cast<typename S::value_type>(std::numeric_limits<S>::min()));
+  }
+
+  template<typename S>
+  constexpr intmax_t Max()
+  {
+    return static_cast<intmax_t>(static_cast<typename S::value_type>(std::numeric_limits<S>::max()));
+  }
+
+  template<typename S>
+  intmax_t Value(S v)
+  {
+    return static_cast<intmax_t>(static_cast<typename S::value_type>(v));
+  }
+
+  template<typename S>
+  bool InRange(S v)
+  {
+    return (Value(v) >= Min<S>()) && (Value(v) <= Max<S>());
+  }
+
+  /// compares against native two's complement operations for every pair of operands
+  template<typename T, typename U>
+  void TestBitwise()
+  {
+    for(intmax_t a = Min<T>(); a <= Max<T>(); ++a)
+    {
+      T const lhs{static_cast<typename T::value_type>(a)};
+      ASSERT_EQ(~a, Value(~lhs));
+      ASSERT_TRUE(InRange(~lhs));
+      for(intmax_t b = Min<U>(); b <= Max<U>(); ++b)
+      {
+        U const rhs{static_cast<typename U::value_type>(b)};
+        ASSERT_EQ(a & b, Value(lhs & rhs)) << a << '&' << b;
+        ASSERT_EQ(a | b, Value(lhs | rhs)) << a << '|' << b;
+        ASSERT_EQ(a ^ b, Value(lhs ^ rhs)) << a << '^' << b;
+        ASSERT_TRUE(InRange(lhs & rhs)) << a << '&' << b;
+        ASSERT_TRUE(InRange(lhs | rhs)) << a << '|' << b;
+        ASSERT_TRUE(InRange(lhs ^ rhs)) << a << '^' << b;
+      }
+    }
+  }
+
+  /// compares against native comparisons for every pair of operands
+  template<typename T, typename U>
+  void TestCompare()
+  {
+    for(intmax_t a = Min<T>(); a <= Max<T>(); ++a)
+    {
+      T const lhs{static_cast<typename T::value_type>(a)};
+      for(intmax_t b = Min<U>(); b <= Max<U>(); ++b)
+      {
+        U const rhs{static_cast<typename U::value_type>(b)};
+        ASSERT_EQ(a < b, lhs < rhs) << a << '<' << b;
+        ASSERT_EQ(a > b, lhs > rhs) << a << '>' << b;
+        ASSERT_EQ(a <= b, lhs <= rhs) << a << "<=" << b;
+        ASSERT_EQ(a >= b, lhs >= rhs) << a << ">=" << b;
+        ASSERT_EQ(a == b, lhs == rhs) << a << "==" << b;
+        ASSERT_EQ(a != b, lhs != rhs) << a << "!=" << b;
+      }
+    }
+  }
+
+  template<typename T, typename S>
+  void TestShift()
+  {
+    using left_type = decltype(std::declval<T>() << std::declval<S>());
+    using right_type = decltype(std::declval<T>() >> std::declval<S>());
+    intmax_t left_min = std::numeric_limits<intmax_t>::max();
+    intmax_t left_max = std::numeric_limits<intmax_t>::min();
+    intmax_t right_min = std::numeric_limits<intmax_t>::max();
+    intmax_t right_max = std::numeric_limits<intmax_t>::min();
+    for(intmax_t a = Min<T>(); a <= Max<T>(); ++a)
+    {
+      for(intmax_t s = Min<S>(); s <= Max<S>(); ++s)
+      {
+        T const lhs{static_cast<typename T::value_type>(a)};
+        S const rhs{static_cast<typename S::value_type>(s)};
+        ASSERT_EQ(a * (intmax_t{1} << s), Value(lhs << rhs)) << a << "<<" << s;
+        ASSERT_EQ((a >= 0) ? (a >> s) : ~(~a >> s), Value(lhs >> rhs)) << a << ">>" << s;
+        left_min = std::min(left_min, Value(lhs << rhs));
+        left_max = std::max(left_max, Value(lhs << rhs));
+        right_min = std::min(right_min, Value(lhs >> rhs));
+        right_max = std::max(right_max, Value(lhs >> rhs));
+      }
+    }
+
+    // shift ranges are exact
+    ASSERT_EQ(left_min, Min<left_type>());
+    ASSERT_EQ(left_max, Max<left_type>());
+    ASSERT_EQ(right_min, Min<right_type>());
+    ASSERT_EQ(right_max, Max<right_type>());
+  }
+}
+
+TEST(SafeInt, Compare)
+{
+  TestCompare<rdk::safe_signed<-10, 10>, rdk::safe_signed<-5, 15>>();
+  TestCompare<rdk::safe_signed<-10, 10>, rdk::safe_unsigned<0U, 20U>>();
+  TestCompare<rdk::safe_unsigned<250U, 300U>, rdk::safe_signed<-128, 127>>();
+}
+
+TEST(SafeInt, Bitwise)
+{
+  TestBitwise<rdk::safe_unsigned<0U, 100U>, rdk::safe_unsigned<3U, 37U>>();
+  TestBitwise<rdk::safe_unsigned<200U, 255U>, rdk::safe_unsigned<0U, 255U>>();
+  TestBitwise<rdk::safe_signed<-100, 100>, rdk::safe_signed<-37, 3>>();
+  TestBitwise<rdk::safe_signed<-100, -50>, rdk::safe_signed<-37, -3>>();
+  TestBitwise<rdk::safe_signed<-100, -50>, rdk::safe_signed<3, 37>>();
+  TestBitwise<rdk::safe_signed<0, 100>, rdk::safe_signed<3, 37>>();
+  TestBitwise<rdk::safe_unsigned<0U, 300U>, rdk::safe_signed<-128, 127>>();
+
+  using byte = rdk::safe_unsigned<0U, 255U>;
+  using nibble = rdk::safe_unsigned<0U, 15U>;
+  static_assert(std::is_same_v<decltype(std::declval<byte>() & std::declval<nibble>()), nibble>, "masking shall narrow the range");
+  static_assert(std::is_same_v<decltype(std::declval<byte>() | std::declval<nibble>()), byte>, "or shall stay within the wider operand's bits");
+  static_assert(std::is_same_v<decltype(std::declval<rdk::safe_unsigned<0U, 300U>>() ^ std::declval<nibble>()), rdk::safe_unsigned<0U, 511U>>, "xor shall stay within both operands' bits");
+  static_assert(std::is_same_v<decltype(~std::declval<byte>()), rdk::safe_signed<-256, -1>>, "complements shall be -v - 1");
+  static_assert(rdk::packable_traits<decltype(std::declval<byte>() & std::declval<nibble>())>::packed_size == 4U, "results shall pack at minimal width");
+
+  constexpr auto masked = byte{0xA5U} & nibble{0xFU};
+  static_assert(static_cast<uint8_t>(masked) == 0x5U, "bitwise operators shall be constexpr");
+}
+
+TEST(SafeInt, Shift)
+{
+  TestShift<rdk::safe_unsigned<3U, 100U>, rdk::safe_unsigned<0U, 5U>>();
+  TestShift<rdk::safe_signed<-100, 37>, rdk::safe_unsigned<2U, 6U>>();
+  TestShift<rdk::safe_signed<-100, -37>, rdk::safe_signed<1, 3>>();
+  TestShift<rdk::safe_signed<-1000, 1000>, rdk::safe_signed<4, 4>>();
+
+  // a constant shift amount widens the range exactly
+  using amount = rdk::safe_unsigned<8U, 8U>;
+  using shifted = decltype(std::declval<rdk::safe_unsigned<0U, 255U>>() << std::declval<amount>());
+  static_assert(std::is_same_v<shifted, rdk::safe_unsigned<0U, 0xFF00U>>, "constant shifts shall widen the range exactly");
+  using wide = rdk::safe_signed<std::numeric_limits<int32_t>::min(), std::numeric_limits<int32_t>::max()>;
+  static_assert(std::is_same_v<decltype(std::declval<wide>() << std::declval<rdk::safe_unsigned<32U, 32U>>())::value_type, int64_t>, "shifts shall widen the storage type as needed");
+  static_assert(std::is_same_v<decltype(std::declval<wide>() >> std::declval<rdk::safe_unsigned<24U, 24U>>()), rdk::safe_signed<-128, 127>>, "right shifts shall narrow the range");
+
+  constexpr auto v = rdk::safe_signed<-8, 7>{-5} >> rdk::safe_unsigned<1U, 1U>{1U};
+  static_assert(static_cast<int8_t>(v) == -3, "right shifts shall round towards negative infinity");
+}
+
+TEST(SafeInt, Conversion)
+{
+  using narrow = rdk::safe_signed<-10, 10>;
+  using wide = rdk::safe_signed<-1000, 1000>;
+  static_assert(noexcept(wide{std::declval<narrow>()}), "widening conversions shall not be checked");
+  static_assert(!noexcept(narrow{std::declval<wide>()}), "narrowing conversions shall be checked");
+  static_assert(narrow{wide{-7}} == narrow{-7}, "conversions shall be constexpr");
+
+  for(int v = -1000; v <= 1000; ++v)
+  {
+    auto const w = wide{static_cast<int16_t>(v)};
+    if((v < -10) || (v > 10))
+    {
+      EXPECT_THROW(narrow{w}, std::domain_error);
+    }
+    else
+    {
+      EXPECT_EQ(v, static_cast<int8_t>(narrow{w}));
+    }
+    EXPECT_EQ(std::clamp(v, -10, 10), static_cast<int8_t>(rdk::safe_signed<-10, 10, rdk::saturate_on_error>{w}));
+    EXPECT_EQ((((v + 10) % 21) + 21) % 21 - 10, static_cast<int8_t>(rdk::safe_signed<-10, 10, rdk::wrap_on_error>{w}));
+  }
+
+  // mixed signedness
+  using u64 = rdk::safe_unsigned<0U, std::numeric_limits<uint64_t>::max()>;
+  using s64 = rdk::safe_signed<std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max()>;
+  EXPECT_THROW(u64{s64{-1}}, std::domain_error);
+  EXPECT_THROW(s64{u64{std::numeric_limits<uint64_t>::max()}}, std::domain_error);
+  EXPECT_EQ(5U, static_cast<uint64_t>(u64{s64{5}}));
+  EXPECT_EQ(0U, static_cast<uint64_t>(rdk::safe_unsigned<0U, std::numeric_limits<uint64_t>::max(), rdk::saturate_on_error>{s64{std::numeric_limits<int64_t>::min()}}));
+  EXPECT_EQ(std::numeric_limits<int64_t>::max(), static_cast<int64_t>(rdk::safe_signed<std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max(), rdk::saturate_on_error>{u64{std::numeric_limits<uint64_t>::max()}}));
+  EXPECT_EQ(200U, static_cast<uint8_t>(rdk::safe_unsigned<0U, 200U>{rdk::safe_signed<-5, 300>{200}}));
+}
+
+TEST(SafeInt, CompoundAssignment)
+{
+  using byte = rdk::safe_unsigned<0U, 255U>;
+  using value = rdk::safe_signed<-1000, 1000>;
+
+  // results within range need no check
+  static_assert(noexcept(std::declval<byte &>() &= std::declval<byte>()), "masking shall not be checked");
+  static_assert(noexcept(std::declval<byte &>() >>= std::declval<rdk::safe_unsigned<0U, 7U>>()), "right shifts shall not be checked");
+  static_assert(noexcept(std::declval<value &>() /= std::declval<rdk::safe_signed<1, 10>>()), "division by divisors without zero shall not be checked");
+  static_assert(noexcept(std::declval<value &>() %= std::declval<rdk::safe_signed<-10, -1>>()), "remainders shall not be checked");
+  static_assert(!noexcept(std::declval<value &>() += std::declval<rdk::safe_signed<0, 1>>()), "sums exceeding the range shall be checked");
+  static_assert(!noexcept(std::declval<byte &>() -= std::declval<byte>()), "differences exceeding the range shall be checked");
+
+  auto x = value{0};
+  for(int i{}; i < 100; ++i)
+  {
+    x += rdk::safe_signed<-5, 10>{10};
+  }
+  EXPECT_EQ(1000, static_cast<int16_t>(x));
+  EXPECT_THROW((x += rdk::safe_signed<1, 1>{1}), std::domain_error);
+  EXPECT_EQ(1000, static_cast<int16_t>(x)) << "failed assignments shall leave the value unchanged";
+  x -= rdk::safe_unsigned<0U, 100U>{100U};
+  x *= rdk::safe_signed<-1, 1>{-1};
+  EXPECT_EQ(-900, static_cast<int16_t>(x));
+  x /= rdk::safe_signed<3, 3>{3};
+  x %= rdk::safe_signed<7, 7>{7};
+  EXPECT_EQ(-300 % 7, static_cast<int16_t>(x));
+  x <<= rdk::safe_unsigned<3U, 3U>{3U};
+  x >>= rdk::safe_unsigned<1U, 1U>{1U};
+  EXPECT_EQ(4 * (-300 % 7), static_cast<int16_t>(x));
+
+  auto b = byte{0xF0U};
+  b |= rdk::safe_unsigned<0U, 15U>{0x0FU};
+  b ^= byte{0x3CU};
+  b &= byte{0x7EU};
+  EXPECT_EQ(0x42U, static_cast<uint8_t>(b));
+
+  // the destination's policy handles results out of range
+  auto s = rdk::safe_signed<-100, 100, rdk::saturate_on_error>{90};
+  for(int i{}; i < 1000; ++i)
+  {
+    auto const step = rdk::safe_signed<-20, 20>{static_cast<int8_t>(static_cast<int>(rng() % 41U) - 20)};
+    auto const expected = std::clamp(static_cast<int>(static_cast<int8_t>(s)) + static_cast<int>(static_cast<int8_t>(step)), -100, 100);
+    s += step;
+    ASSERT_EQ(expected, static_cast<int8_t>(s));
+  }
+}
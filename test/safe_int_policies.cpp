@@ -0,0 +1,119 @@
+#include "safe_int.hpp"
+
+#include <vector>
+
+namespace
+{
+  struct test_counter
+  {
+  };
+
+  template<typename S>
+  intmax_t Value(S v)
+  {
+    return static_cast<intmax_t>(static_cast<typename S::value_type>(v));
+  }
+
+  /// checks construction from every value around the range against a reference
+  template<typename S, typename F>
+  void TestConstruction(F reference)
+  {
+    using value_type = typename S::value_type;
+    constexpr auto min = static_cast<intmax_t>(static_cast<value_type>(std::numeric_limits<S>::min()));
+    constexpr auto max = static_cast<intmax_t>(static_cast<value_type>(std::numeric_limits<S>::max()));
+    for(intmax_t v = std::max<intmax_t>(min - 100, std::numeric_limits<value_type>::min()); v <= std::min<intmax_t>(max + 100, std::numeric_limits<value_type>::max()); ++v)
+    {
+      ASSERT_EQ(reference(v), Value(S{static_cast<value_type>(v)})) << v;
+    }
+  }
+}
+
+TEST(SafeInt, Policies)
+{
+  static_assert(std::is_same_v<rdk::safe_signed<-1, 1>::policy_type, rdk::throw_on_error>, "throwing shall be the default");
+  static_assert(!noexcept(rdk::safe_signed<-1, 1>{0}), "throwing construction shall not be noexcept");
+  static_assert(noexcept(rdk::safe_signed<-1, 1, rdk::saturate_on_error>{0}), "saturating construction shall be noexcept");
+  static_assert(noexcept(++std::declval<rdk::safe_signed<-1, 1, rdk::wrap_on_error> &>()), "wrapping increments shall be noexcept");
+  static_assert(noexcept(rdk::safe_signed<-1, 1, rdk::terminate_on_error>{0}), "terminating construction shall be noexcept");
+
+  // policies don't change layout, packing or arithmetic
+  using saturated = rdk::safe_unsigned<10U, 20U, rdk::saturate_on_error>;
+  static_assert(sizeof(saturated) == 1U, "policies shall not add storage");
+  static_assert(rdk::packable_traits<saturated>::packed_size == 4U, "policies shall not change packing");
+  static_assert(std::is_same_v<decltype(saturated{10U} + saturated{10U}), rdk::safe_unsigned<20U, 40U>>, "arithmetic results shall use the default policy");
+  static_assert(saturated{100U} == rdk::safe_unsigned<20U, 20U>{20U}, "policies shall be constexpr");
+  using traits = rdk::packable_traits<saturated>;
+  EXPECT_TRUE(saturated{15U} == traits::unpack(traits::pack(saturated{15U})));
+}
+
+TEST(SafeInt, ThrowPolicy)
+{
+  using type = rdk::safe_signed<-5, 5>;
+  EXPECT_THROW(type{6}, std::domain_error);
+  EXPECT_THROW(type{-6}, std::domain_error);
+  auto v = type{5};
+  EXPECT_THROW(++v, std::domain_error);
+  EXPECT_EQ(5, Value(v));
+  v = type{-5};
+  EXPECT_THROW(v--, std::domain_error);
+  EXPECT_EQ(-5, Value(v));
+}
+
+TEST(SafeInt, TerminatePolicy)
+{
+  using type = rdk::safe_signed<-5, 5, rdk::terminate_on_error>;
+  EXPECT_EQ(3, Value(type{3}));
+  EXPECT_DEATH(type{6}, "");
+  EXPECT_DEATH(++type{5}, "");
+}
+
+TEST(SafeInt, SaturatePolicy)
+{
+  TestConstruction<rdk::safe_signed<-5, 5, rdk::saturate_on_error>>([](intmax_t v) { return std::clamp<intmax_t>(v, -5, 5); });
+  TestConstruction<rdk::safe_unsigned<3U, 200U, rdk::saturate_on_error>>([](intmax_t v) { return std::clamp<intmax_t>(v, 3, 200); });
+  TestConstruction<rdk::safe<int8_t, -128, 127, rdk::saturate_on_error>>([](intmax_t v) { return v; });
+
+  auto v = rdk::safe_signed<-5, 5, rdk::saturate_on_error>{4};
+  EXPECT_EQ(5, Value(++v));
+  EXPECT_EQ(5, Value(v++));
+  EXPECT_EQ(5, Value(v));
+  v = decltype(v){-4};
+  EXPECT_EQ(-5, Value(--v));
+  EXPECT_EQ(-5, Value(--v));
+}
+
+TEST(SafeInt, WrapPolicy)
+{
+  TestConstruction<rdk::safe_signed<-5, 5, rdk::wrap_on_error>>([](intmax_t v) { return ((((v + 5) % 11) + 11) % 11) - 5; });
+  TestConstruction<rdk::safe_unsigned<3U, 200U, rdk::wrap_on_error>>([](intmax_t v) { return ((((v - 3) % 198) + 198) % 198) + 3; });
+  TestConstruction<rdk::safe_signed<100, 1000, rdk::wrap_on_error>>([](intmax_t v) { return ((((v - 100) % 901) + 901) % 901) + 100; });
+
+  using full = rdk::safe<int64_t, std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max(), rdk::wrap_on_error>;
+  EXPECT_EQ(std::numeric_limits<int64_t>::min(), Value(full{std::numeric_limits<int64_t>::min()}));
+  using wide = rdk::safe<int64_t, std::numeric_limits<int64_t>::min() + 1, std::numeric_limits<int64_t>::max(), rdk::wrap_on_error>;
+  EXPECT_EQ(std::numeric_limits<int64_t>::max(), Value(wide{std::numeric_limits<int64_t>::min()}));
+
+  auto v = rdk::safe_signed<-5, 5, rdk::wrap_on_error>{5};
+  EXPECT_EQ(-5, Value(++v));
+  EXPECT_EQ(5, Value(--v));
+  auto u = rdk::safe_unsigned<0U, 255U, rdk::wrap_on_error>{255U};
+  EXPECT_EQ(0, Value(++u));
+  EXPECT_EQ(255, Value(--u));
+}
+
+TEST(SafeInt, CountPolicy)
+{
+  using policy = rdk::count_on_error<test_counter>;
+  using type = rdk::safe_signed<-5, 5, policy>;
+  EXPECT_EQ(0U, policy::errors.load());
+  EXPECT_EQ(5, Value(type{6}));
+  EXPECT_EQ(-5, Value(type{-100}));
+  EXPECT_EQ(2U, policy::errors.load());
+
+  auto v = type{4};
+  EXPECT_EQ(5, Value(++v));
+  EXPECT_EQ(2U, policy::errors.load());
+  EXPECT_EQ(5, Value(++v));
+  EXPECT_EQ(3U, policy::errors.load());
+  EXPECT_EQ(0U, rdk::count_on_error<>::errors.load()) << "counters shall be separate per tag";
+}
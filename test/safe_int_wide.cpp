@@ -0,0 +1,117 @@
+#include "packed_vector.hpp"
+#include "safe_int.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#ifdef RDK_HAS_INT128
+namespace
+{
+  using rdk::detail::int128_t;
+  using rdk::detail::uint128_t;
+
+  using u64 = rdk::safe_unsigned<0U, std::numeric_limits<uint64_t>::max()>;
+  using i64 = rdk::safe_signed<std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max()>;
+
+  template<typename S>
+  constexpr auto Native(S v)
+  {
+    return static_cast<typename S::value_type>(v);
+  }
+}
+
+TEST(SafeInt, WideDeduction)
+{
+  using sum = decltype(std::declval<u64>() + std::declval<u64>());
+  static_assert(std::is_same_v<sum::value_type, uint128_t>, "sums of 64 bit values shall be stored in 128 bits");
+  static_assert(Native(std::numeric_limits<sum>::max()) == (uint128_t{std::numeric_limits<uint64_t>::max()} * 2U), "sums shall keep the exact range");
+
+  using difference = decltype(std::declval<u64>() - std::declval<u64>());
+  static_assert(std::is_same_v<difference::value_type, int128_t>, "differences of unsigned values shall be signed");
+  static_assert(Native(std::numeric_limits<difference>::min()) == -int128_t{std::numeric_limits<uint64_t>::max()}, "differences shall keep the exact range");
+
+  using product = decltype(std::declval<i64>() * std::declval<i64>());
+  static_assert(std::is_same_v<product::value_type, int128_t>, "products of 64 bit values shall be stored in 128 bits");
+  static_assert(Native(std::numeric_limits<product>::max()) == (int128_t{std::numeric_limits<int64_t>::min()} * std::numeric_limits<int64_t>::min()), "products shall keep the exact range");
+
+  static_assert(std::is_same_v<rdk::safe_signed<-1, rdk::detail::intwide_t{1} << 64>::value_type, int128_t>, "wide ranges shall be stored in 128 bits");
+  static_assert(std::is_same_v<rdk::safe_unsigned<0U, rdk::detail::uintwide_t{1} << 64>::value_type, uint128_t>, "wide ranges shall be stored in 128 bits");
+  static_assert(std::numeric_limits<product>::is_signed && std::numeric_limits<product>::is_integer, "limits shall describe wide values");
+}
+
+TEST(SafeInt, WideArithmetic)
+{
+  std::uniform_int_distribution<uint64_t> udist;
+  std::uniform_int_distribution<int64_t> sdist;
+  for(size_t i{}; i < 10000U; ++i)
+  {
+    auto const a = udist(rng);
+    auto const b = udist(rng);
+    ASSERT_TRUE(Native(u64{a} + u64{b}) == (uint128_t{a} + b));
+    ASSERT_TRUE(Native(u64{a} - u64{b}) == (int128_t{a} - int128_t{b}));
+    ASSERT_TRUE(Native(u64{a} * u64{b}) == (uint128_t{a} * b));
+
+    auto const c = sdist(rng);
+    auto const d = sdist(rng);
+    ASSERT_TRUE(Native(i64{c} + i64{d}) == (int128_t{c} + d));
+    ASSERT_TRUE(Native(i64{c} - i64{d}) == (int128_t{c} - d));
+    ASSERT_TRUE(Native(i64{c} * i64{d}) == (int128_t{c} * d));
+    ASSERT_EQ((i64{c} < i64{d}), (c < d));
+    ASSERT_TRUE((u64{a} + u64{b}) == (u64{b} + u64{a}));
+  }
+}
+
+TEST(SafeInt, WideConversion)
+{
+  constexpr auto max = std::numeric_limits<uint64_t>::max();
+  auto const sum = u64{max} + u64{1U};
+  EXPECT_THROW(u64{sum}, std::domain_error);
+  ASSERT_TRUE(Native(rdk::safe_unsigned<0U, max, rdk::saturate_on_error>{sum}) == max);
+  ASSERT_TRUE(Native(u64{u64{max - 1U} + u64{0U}}) == (max - 1U));
+
+  auto const difference = u64{0U} - u64{max};
+  EXPECT_THROW(i64{difference}, std::domain_error);
+
+  // a 64 bit counter accumulating into its own range
+  u64 counter{max - 10U};
+  counter += u64{10U};
+  ASSERT_EQ(max, Native(counter));
+  EXPECT_THROW(counter += u64{1U}, std::domain_error);
+  ASSERT_EQ(max, Native(counter));
+}
+
+TEST(SafeInt, WidePacking)
+{
+  using sum = decltype(std::declval<u64>() + std::declval<u64>());
+  using traits = rdk::packable_traits<sum>;
+  static_assert(rdk::is_packable_v<sum>, "wide values shall be packable");
+  static_assert(traits::packed_size == 65U, "wide values shall be packed densely");
+  static_assert(rdk::packable_traits<decltype(std::declval<i64>() * std::declval<i64>())>::packed_size == 127U, "wide values shall be packed densely");
+  static_assert(rdk::packable_traits<rdk::safe_signed<-1, rdk::detail::intwide_t{1} << 64>>::packed_size == 65U, "wide values shall be packed densely");
+
+  std::uniform_int_distribution<uint64_t> dist;
+  std::vector<sum> values;
+  for(size_t i{}; i < 1000U; ++i)
+  {
+    values.push_back(u64{dist(rng)} + u64{dist(rng)});
+    ASSERT_TRUE(values.back() == traits::unpack(traits::pack(values.back())));
+  }
+  values.push_back(std::numeric_limits<sum>::max());
+  values.push_back(std::numeric_limits<sum>::min());
+
+  rdk::packed_vector<sum> const packed(values.begin(), values.end());
+  ASSERT_TRUE(std::equal(values.begin(), values.end(), packed.begin()));
+
+  using product = decltype(std::declval<i64>() * std::declval<i64>());
+  std::uniform_int_distribution<int64_t> sdist;
+  std::vector<product> products{std::numeric_limits<product>::min(), std::numeric_limits<product>::max()};
+  for(size_t i{}; i < 1000U; ++i)
+  {
+    products.push_back(i64{sdist(rng)} * i64{sdist(rng)});
+  }
+  rdk::packed_vector<product> const packed_products(products.begin(), products.end());
+  ASSERT_TRUE(std::equal(products.begin(), products.end(), packed_products.begin()));
+}
+#endif
@@ -0,0 +1,102 @@
+#include "safe_span.hpp"
+
+#include <numeric>
+#include <vector>
+
+namespace
+{
+  /// a value just outside of the range of S, either below or above it
+  template<typename S>
+  typename S::value_type BadValue(bool below)
+  {
+    using value_type = typename S::value_type;
+    constexpr auto min = static_cast<value_type>(std::numeric_limits<S>::min());
+    constexpr auto max = static_cast<value_type>(std::numeric_limits<S>::max());
+    return (below && (min != rdk::detail::integer_limits<value_type>::min())) || (max == rdk::detail::integer_limits<value_type>::max()) ? static_cast<value_type>(min - 1) : static_cast<value_type>(max + 1);
+  }
+
+  template<typename S>
+  void TestValidate()
+  {
+    using value_type = typename S::value_type;
+    for(size_t n : {0U, 1U, 7U, 31U, 32U, 33U, 127U, 128U, 129U, 1000U})
+    {
+      std::vector<value_type> values;
+      for(size_t i{}; i < n; ++i)
+      {
+        values.push_back(static_cast<value_type>(RandomValue<S>()));
+      }
+
+      auto const valid = rdk::validate<S>(values);
+      ASSERT_TRUE(valid.has_value()) << n;
+      ASSERT_EQ(n, valid->size());
+      ASSERT_EQ(static_cast<void const *>(values.data()), static_cast<void const *>(valid->data())) << "validation shall not copy";
+      for(size_t i{}; i < n; ++i)
+      {
+        ASSERT_TRUE(values[i] == static_cast<value_type>((*valid)[i])) << i;
+      }
+
+      // every native value is in range of types covering their whole value type
+      for(size_t k{}; !rdk::detail::validate_element<S>::trivial && (0U != n) && (k < 20U); ++k)
+      {
+        auto bad = values;
+        size_t const first = std::uniform_int_distribution<size_t>(0U, n - 1U)(rng);
+        bad[first] = BadValue<S>(0U == (k % 2U));
+        // later bad values don't matter
+        for(size_t i = first + 1U; i < n; i += 1U + (rng() % 5U))
+        {
+          bad[i] = BadValue<S>(0U != (k % 2U));
+        }
+
+        auto const invalid = rdk::validate<S>(bad);
+        ASSERT_FALSE(invalid);
+        ASSERT_EQ(first, invalid.error().index) << n;
+        ASSERT_EQ(first, rdk::detail::validate_scalar<S>(bad.data(), n));
+#ifdef RDK_X86_64
+        if constexpr(sizeof(value_type) <= sizeof(uint64_t))
+        {
+          if(rdk::detail::cpu.avx2)
+          {
+            ASSERT_LE(rdk::detail::validate_avx2<S>(bad.data(), n), first);
+          }
+        }
+#endif
+      }
+    }
+  }
+}
+
+TEST(SafeSpan, Span)
+{
+  int32_t array[5]{1, 2, 3, 4, 5};
+  rdk::span<int32_t> const s(array);
+  rdk::span<int32_t const> const c = s;
+  EXPECT_EQ(5U, c.size());
+  EXPECT_EQ(3, c.subspan(2U, 2U)[0]);
+  EXPECT_EQ(15, std::accumulate(c.begin(), c.end(), 0));
+
+  std::vector<int16_t> const v{1, 2};
+  EXPECT_EQ(2U, rdk::span<int16_t const>(v).size());
+
+  rdk::expected<int, rdk::first_bad_index> const e = rdk::first_bad_index{3U};
+  EXPECT_FALSE(e);
+  EXPECT_EQ(3U, e.error().index);
+  EXPECT_THROW(e.value(), std::logic_error);
+}
+
+TEST(SafeSpan, Validate)
+{
+  TestValidate<rdk::safe_signed<-100, 100>>();
+  TestValidate<rdk::safe_unsigned<10U, 200U>>();
+  TestValidate<rdk::safe_signed<-1000, 30000>>();
+  TestValidate<rdk::safe_unsigned<0U, 40000U>>();
+  TestValidate<rdk::safe<int32_t, -5, 1000000>>();
+  TestValidate<rdk::safe<uint32_t, 3000000000U, 4000000000U>>();
+  TestValidate<rdk::safe_signed<std::numeric_limits<int64_t>::min() + 1, 5>>();
+  TestValidate<rdk::safe<uint64_t, 0U, std::numeric_limits<uint64_t>::max() - 1U>>();
+  TestValidate<rdk::safe<uint16_t, 0U, 65535U, rdk::saturate_on_error>>();
+#ifdef RDK_HAS_INT128
+  TestValidate<rdk::safe_signed<-(rdk::detail::intwide_t{1} << 70), rdk::detail::intwide_t{1} << 70>>();
+  TestValidate<rdk::safe_unsigned<rdk::detail::uintwide_t{1} << 64, rdk::detail::uintwide_t{1} << 100>>();
+#endif
+}
@@ -0,0 +1,147 @@
+#include "bit_io.hpp"
+#include "packed_optional.hpp"
+#include "packed_vector.hpp"
+#include "safe_stepped.hpp"
+
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+  /// uniformly distributed over the steps
+  template<typename T>
+  T RandomStepped()
+  {
+    using value_type = typename T::value_type;
+    std::uniform_int_distribution<uintmax_t> dist(0U, T::max_index);
+    return T{static_cast<value_type>(static_cast<uintmax_t>(static_cast<value_type>(std::numeric_limits<T>::min())) + (dist(rng) * static_cast<uintmax_t>(T::step_size)))};
+  }
+
+  template<typename T>
+  void TestRoundTrip()
+  {
+    using traits = rdk::packable_traits<T>;
+    static_assert(rdk::is_packable_v<T>, "stepped safe integers shall be packable");
+
+    std::vector<T> values{std::numeric_limits<T>::min(), std::numeric_limits<T>::max()};
+    for(size_t i{}; i < 1000U; ++i)
+    {
+      values.push_back(RandomStepped<T>());
+    }
+
+    std::vector<std::byte> buffer(((values.size() * traits::packed_size) + 7U) / 8U);
+    rdk::bit_writer writer(buffer.data(), buffer.size());
+    for(auto const &v : values)
+    {
+      ASSERT_EQ(v.index(), traits::pack(v).extract(0U, traits::packed_size));
+      ASSERT_EQ(v, traits::unpack(traits::pack(v)));
+      writer.write(v);
+    }
+    writer.flush();
+
+    for(size_t i{}; i < values.size(); ++i)
+    {
+      ASSERT_EQ(values[i], rdk::unpack_from<T>(buffer.data(), i * traits::packed_size));
+    }
+
+    rdk::packed_vector<T> const packed(values.begin(), values.end());
+    ASSERT_TRUE(std::equal(values.begin(), values.end(), packed.begin()));
+  }
+}
+
+TEST(SafeStepped, Construction)
+{
+  using type = rdk::safe_stepped_unsigned<0U, 10000U, 10U>;
+  EXPECT_EQ(static_cast<uint16_t>(type{9990U}), 9990U);
+  EXPECT_THROW(type{9995U}, std::domain_error);
+  EXPECT_THROW(type{10010U}, std::domain_error);
+  EXPECT_EQ(type{120U}.index(), 12U);
+  EXPECT_EQ(type::from_index(1000U), type{10000U});
+
+  using signed_type = rdk::safe_stepped_signed<-15, 35, 5>;
+  EXPECT_EQ(static_cast<int8_t>(signed_type{-10}), -10);
+  EXPECT_EQ(signed_type{-15}.index(), 0U);
+  EXPECT_EQ(signed_type{35}.index(), 10U);
+  EXPECT_THROW(signed_type{-14}, std::domain_error);
+  EXPECT_THROW(signed_type{-20}, std::domain_error);
+  EXPECT_THROW(signed_type{36}, std::domain_error);
+
+  // every value in range is accepted exactly when it is a whole number of steps away from min
+  using odd_type = rdk::safe_stepped_signed<-1000, 1002, 7>;
+  for(int v = -1000; v <= 1002; ++v)
+  {
+    if(0 == ((v + 1000) % 7))
+    {
+      EXPECT_EQ(static_cast<int16_t>(odd_type{static_cast<int16_t>(v)}), v);
+    }
+    else
+    {
+      EXPECT_THROW(odd_type{static_cast<int16_t>(v)}, std::domain_error);
+    }
+  }
+}
+
+TEST(SafeStepped, Arithmetic)
+{
+  using a_type = rdk::safe_stepped_unsigned<0U, 10000U, 10U>;
+  using b_type = rdk::safe_stepped_signed<-15, 35, 5>;
+
+  auto const sum = a_type{100U} + b_type{-15};
+  using sum_type = std::remove_const_t<decltype(sum)>;
+  static_assert(sum_type::step_size == 5, "steps shall combine to their gcd");
+  static_assert(static_cast<int16_t>(std::numeric_limits<sum_type>::min()) == -15, "ranges shall be propagated");
+  static_assert(static_cast<int16_t>(std::numeric_limits<sum_type>::max()) == 10035, "ranges shall be propagated");
+  EXPECT_EQ(static_cast<int16_t>(sum), 85);
+
+  auto const diff = b_type{0} - a_type{10000U};
+  using diff_type = std::remove_const_t<decltype(diff)>;
+  static_assert(diff_type::step_size == 5, "steps shall combine to their gcd");
+  static_assert(static_cast<int16_t>(std::numeric_limits<diff_type>::min()) == -10015, "ranges shall be propagated");
+  static_assert(static_cast<int16_t>(std::numeric_limits<diff_type>::max()) == 35, "ranges shall be propagated");
+  EXPECT_EQ(static_cast<int16_t>(diff), -10000);
+
+  using c_type = rdk::safe_stepped_unsigned<3U, 24U, 3U>;
+  using d_type = rdk::safe_stepped_unsigned<0U, 40U, 4U>;
+  using cd_type = decltype(c_type{3U} + d_type{0U});
+  static_assert(cd_type::step_size == 1, "coprime steps shall combine to 1");
+  EXPECT_TRUE(c_type{6U} < c_type{9U});
+  EXPECT_TRUE(c_type{6U} != c_type{9U});
+  EXPECT_TRUE(c_type{9U} > c_type{6U});
+  EXPECT_TRUE(c_type{6U} <= c_type{9U});
+  EXPECT_TRUE(c_type{9U} >= c_type{9U});
+  EXPECT_FALSE(c_type{6U} >= c_type{9U});
+  EXPECT_TRUE(a_type{20U} <= b_type{20});
+  EXPECT_FALSE(a_type{20U} > b_type{20});
+  EXPECT_TRUE(a_type{20U} == b_type{20});
+}
+
+TEST(SafeStepped, Packing)
+{
+  static_assert(rdk::packable_traits<rdk::safe_stepped_unsigned<0U, 10000U, 10U>>::packed_size == 10U, "values shall be packed by step index");
+  static_assert(rdk::packable_traits<rdk::safe_unsigned<0U, 10000U>>::packed_size == 14U, "the plain range takes 14 bits");
+  static_assert(rdk::packable_traits<rdk::safe_stepped_unsigned<7U, 7U, 1U>>::packed_size == 0U, "a single value takes no bits");
+  static_assert(rdk::packable_traits<rdk::safe_stepped_signed<-100, 100, 100>>::packed_size == 2U, "values shall be packed by step index");
+
+  using type = rdk::safe_stepped_signed<-15, 35, 5>;
+  constexpr auto packed = rdk::packable_traits<type>::pack(type{20});
+  static_assert(packed.extract(0U, 4U) == 7U, "packing shall be constexpr");
+  static_assert(rdk::packable_traits<type>::unpack(packed) == type{20}, "unpacking shall be constexpr");
+
+  // the unused codes past max_index hold an empty optional
+  static_assert(rdk::packable_traits<type>::has_niche, "unused codes shall be available as niche");
+  static_assert(rdk::packable_traits<std::optional<type>>::packed_size == 4U, "optionals shall use the niche");
+  EXPECT_FALSE(rdk::packable_traits<std::optional<type>>::unpack(rdk::packable_traits<std::optional<type>>::pack(std::nullopt)).has_value());
+  EXPECT_EQ(*rdk::packable_traits<std::optional<type>>::unpack(rdk::packable_traits<std::optional<type>>::pack(type{35})), type{35});
+}
+
+TEST(SafeStepped, RoundTrip)
+{
+  TestRoundTrip<rdk::safe_stepped_unsigned<0U, 10000U, 10U>>();
+  TestRoundTrip<rdk::safe_stepped_signed<-15, 35, 5>>();
+  TestRoundTrip<rdk::safe_stepped_signed<-1000000, 999998, 7>>();
+  TestRoundTrip<rdk::safe_stepped_unsigned<1000U, 1000U, 3U>>();
+  TestRoundTrip<rdk::safe_stepped<int64_t, std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max(), 3>>();
+  TestRoundTrip<rdk::safe_stepped<uint64_t, 0U, std::numeric_limits<uint64_t>::max(), 5U>>();
+  TestRoundTrip<rdk::safe_stepped<uint64_t, 3U, 3U + (uint64_t{3U} << 62U), uint64_t{1U} << 62U>>();
+}